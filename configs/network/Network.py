@@ -62,8 +62,9 @@ def define_options(parser):
     parser.add_argument(
         "--network",
         default="simple",
-        choices=["simple", "garnet"],
-        help="""'simple'|'garnet' (garnet2.0 will be deprecated.)""",
+        choices=["simple", "garnet", "analytical"],
+        help="""'simple'|'garnet'|'analytical' (garnet2.0 will be
+            deprecated.)""",
     )
     parser.add_argument(
         "--router-latency",
@@ -170,6 +171,14 @@ def define_options(parser):
         help="""SimpleNetwork links uses a separate physical
             channel for each virtual network""",
     )
+    parser.add_argument(
+        "--analytical-queueing-factor",
+        action="store",
+        type=float,
+        default=1.0,
+        help="""scaling of the queueing delay of the analytical
+            network, e.g., to calibrate it against garnet""",
+    )
 
 
 def create_network(options, ruby):
@@ -192,6 +201,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "analytical":
+        NetworkClass = AnalyticalNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
@@ -328,6 +344,9 @@ def init_network(options, network, InterfaceClass):
             )
         network.setup_buffers()
 
+    if options.network == "analytical":
+        network.queueing_factor = options.analytical_queueing_factor
+
     if InterfaceClass != None:
         netifs = [
             InterfaceClass(id=i) for (i, n) in enumerate(network.ext_links)
@@ -155,6 +155,8 @@ class Decoder : public InstDecoder
     void
     setContext(FPSCR fpscr)
     {
+        if (fpscrLen != fpscr.len || fpscrStride != fpscr.stride)
+            ++_context;
         fpscrLen = fpscr.len;
         fpscrStride = fpscr.stride;
     }
@@ -162,12 +164,16 @@ class Decoder : public InstDecoder
     void
     setSveLen(uint8_t len)
     {
+        if (sveLen != len)
+            ++_context;
         sveLen = len;
     }
 
     void
     setSmeLen(uint8_t len)
     {
+        if (smeLen != len)
+            ++_context;
         smeLen = len;
     }
 };
@@ -50,6 +50,7 @@ class BasicDecodeCache
         EMI machInst;
     };
     decode_cache::AddrMap<AddrMapEntry> decodePages;
+    decode_cache::Lookaside<EMI> lookaside;
 
   public:
     /// Decode a machine instruction.
@@ -58,20 +59,23 @@ class BasicDecodeCache
     StaticInstPtr
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
-        auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
-            return entry.inst;
+        if (StaticInstPtr *inst = lookaside.find(addr, mach_inst))
+            return *inst;
 
-        entry.machInst = mach_inst;
+        auto &entry = decodePages.lookup(addr);
+        if (!entry.inst || !(entry.machInst == mach_inst)) {
+            entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
+            auto iter = instMap.find(mach_inst);
+            if (iter != instMap.end()) {
+                entry.inst = iter->second;
+            } else {
+                entry.inst = decoder->decodeInst(mach_inst);
+                instMap[mach_inst] = entry.inst;
+            }
         }
 
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        lookaside.insert(addr, mach_inst, entry.inst);
         return entry.inst;
     }
 };
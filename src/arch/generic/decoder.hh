@@ -49,6 +49,12 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    /**
+     * Incremented whenever state other than the PC and the instruction
+     * bytes that affects decoding changes.
+     */
+    uint64_t _context = 0;
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
@@ -92,6 +98,14 @@ class InstDecoder : public SimObject
         outOfBytes = old->outOfBytes;
     }
 
+    /**
+     * Identify the decoding context. Instructions decoded with the
+     * same PC, instruction bytes and context decode the same way, which
+     * lets CPUs reuse decoded instructions as long as this value is
+     * unchanged.
+     */
+    uint64_t context() const { return _context; }
+
     void *moreBytesPtr() const { return _moreBytesPtr; }
     size_t moreBytesSize() const { return _moreBytesSize; }
     Addr pcMask() const { return _pcMask; }
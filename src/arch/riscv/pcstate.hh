@@ -78,6 +78,13 @@ class PCState : public GenericISA::UPCState<4>
         _rv_type = pcstate._rv_type;
     }
 
+    bool
+    equals(const PCStateBase &other) const override
+    {
+        auto &opc = other.as<PCState>();
+        return Base::equals(other) && _rv_type == opc._rv_type;
+    }
+
     void compressed(bool c) { _compressed = c; }
     bool compressed() const { return _compressed; }
 
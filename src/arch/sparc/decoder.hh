@@ -78,6 +78,8 @@ class Decoder : public InstDecoder
     void
     setContext(RegVal _asi)
     {
+        if (asi != _asi)
+            ++_context;
         asi = _asi;
     }
 
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+template <typename T>
+void
+store(uint8_t *&p, T value)
+{
+    value = htole(value);
+    memcpy(p, &value, sizeof(value));
+    p += sizeof(value);
+}
+
+} // anonymous namespace
+
+BinaryLogger::BinaryLogger(const std::string &_filename)
+    : fd(-1), filename(_filename), window(nullptr), windowOffset(0),
+      windowSize(0), pos(0), buf(*this), stream(&buf)
+{
+    recordArgs = true;
+
+    fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0664);
+    fatal_if(fd < 0, "Unable to open debug trace '%s' for writing: %s\n",
+             filename, strerror(errno));
+
+    map(0, WindowSize);
+    uint8_t *p = window;
+    memcpy(p, "gem5trce", 8);
+    p += 8;
+    store(p, Version);
+    store(p, (uint32_t)0);
+    pos = p - window;
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close();
+}
+
+void
+BinaryLogger::close()
+{
+    stream.flush();
+
+    std::lock_guard<UncontendedMutex> lock(mutex);
+    if (fd < 0)
+        return;
+
+    munmap(window, windowSize);
+    window = nullptr;
+    if (ftruncate(fd, windowOffset + pos) != 0)
+        warn("Unable to truncate debug trace '%s'\n", filename);
+    ::close(fd);
+    fd = -1;
+}
+
+void
+BinaryLogger::map(size_t offset, size_t size)
+{
+    if (window)
+        munmap(window, windowSize);
+
+    // Growing the file leaves zeros behind the last record, which is
+    // where a reader stops if the file is never closed
+    fatal_if(ftruncate(fd, offset + size) != 0,
+             "Unable to grow debug trace '%s': %s\n",
+             filename, strerror(errno));
+
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, offset);
+    fatal_if(addr == MAP_FAILED, "Unable to map debug trace '%s': %s\n",
+             filename, strerror(errno));
+
+    window = static_cast<uint8_t *>(addr);
+    windowOffset = offset;
+    windowSize = size;
+}
+
+uint8_t *
+BinaryLogger::reserve(size_t size)
+{
+    if (pos + size > windowSize) {
+        // Move the window so that it starts at the page of the end of
+        // the file
+        static const size_t page_size = sysconf(_SC_PAGESIZE);
+        const size_t end = windowOffset + pos;
+        const size_t offset = roundDown(end, page_size);
+        pos = end - offset;
+        map(offset, std::max(WindowSize, roundUp(pos + size, page_size)));
+    }
+
+    uint8_t *p = window + pos;
+    pos += size;
+    return p;
+}
+
+uint32_t
+BinaryLogger::intern(const std::string &str)
+{
+    auto [it, inserted] = strings.emplace(str, stringById.size());
+    if (!inserted)
+        return it->second;
+
+    stringById.push_back(&it->first);
+
+    const uint32_t len = str.size();
+    uint8_t *record = reserve(1 + 2 * sizeof(uint32_t) + len);
+    uint8_t *p = record + 1;
+    store(p, it->second);
+    store(p, len);
+    memcpy(p, str.data(), len);
+
+    // The kind is written last so that a reader never sees a partial
+    // record
+    record[0] = StringRecord;
+    return it->second;
+}
+
+uint32_t
+BinaryLogger::internFormat(const char *fmt)
+{
+    auto it = formats.find(fmt);
+    if (it != formats.end() && *stringById[it->second] == fmt)
+        return it->second;
+
+    const uint32_t id = intern(fmt);
+    formats[fmt] = id;
+    return id;
+}
+
+void
+BinaryLogger::writeMessage(Tick when, uint32_t name, uint32_t flag,
+                           uint32_t fmt, const uint8_t *args, uint32_t size)
+{
+    uint8_t *record = reserve(1 + sizeof(uint64_t) +
+                              4 * sizeof(uint32_t) + size);
+    uint8_t *p = record + 1;
+    store(p, (uint64_t)when);
+    store(p, name);
+    store(p, flag);
+    store(p, fmt);
+    store(p, size);
+    memcpy(p, args, size);
+    record[0] = MessageRecord;
+}
+
+void
+BinaryLogger::logRecord(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const RecordArgs &args)
+{
+    std::lock_guard<UncontendedMutex> lock(mutex);
+    if (fd < 0)
+        return;
+
+    const uint32_t name_id = intern(name);
+    const uint32_t flag_id = intern(flag);
+    const uint32_t fmt_id = internFormat(fmt);
+    writeMessage(when, name_id, flag_id, fmt_id, args.data(), args.size());
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    RecordArgs &args = threadRecordArgs();
+    args.clear();
+    args.add(message);
+    logRecord(when, name, flag, "%s", args);
+}
+
+BinaryLogger::LineBuf::int_type
+BinaryLogger::LineBuf::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    line += traits_type::to_char_type(c);
+    if (c == '\n')
+        sync();
+    return c;
+}
+
+int
+BinaryLogger::LineBuf::sync()
+{
+    if (!line.empty()) {
+        logger.logMessage(MaxTick, "", "", line);
+        line.clear();
+    }
+    return 0;
+}
+
+} // namespace trace
+} // namespace gem5
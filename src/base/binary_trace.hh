@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary debug trace output.
+ *
+ * Instead of formatting every debug message, the binary logger records
+ * the format string, the raw arguments, the tick and the name of the
+ * object that printed it. Strings that appear in many messages, such
+ * as format strings, object names and flags, are written once and are
+ * afterwards referred to by their id. Formatting is deferred to
+ * util/decode_binary_trace.py.
+ *
+ * The file is written through a memory mapped window, so records that
+ * were logged before the simulator crashed still end up in the file.
+ *
+ * All values are little endian:
+ *
+ *   header:   char magic[8] = "gem5trce", uint32 version, uint32 zero
+ *   string:   uint8 'S', uint32 id, uint32 length, chars
+ *   message:  uint8 'M', uint64 tick, uint32 name id, uint32 flag id,
+ *             uint32 format id, uint32 args size, args
+ *   argument: uint8 type, value (see trace::RecordArgs)
+ *
+ * A zero kind marks the end of the records.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/uncontended_mutex.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+class BinaryLogger : public Logger
+{
+  public:
+    /** Record kinds. */
+    enum RecordKind : uint8_t
+    {
+        EndRecord = 0,
+        StringRecord = 'S',
+        MessageRecord = 'M',
+    };
+
+    static constexpr uint32_t Version = 1;
+
+    /** Size of the part of the file that is mapped at a time. */
+    static constexpr size_t WindowSize = 16 * 1024 * 1024;
+
+    BinaryLogger(const std::string &filename);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    void logRecord(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const RecordArgs &args) override;
+
+    /**
+     * Text written to this stream is recorded line by line as messages
+     * without a tick or a name.
+     */
+    std::ostream &getOstream() override { return stream; }
+
+    /**
+     * Truncate the file to the records written so far and close it.
+     * Messages logged after this are dropped.
+     */
+    void close();
+
+  protected:
+    /** Turns lines written to the ostream into messages. */
+    class LineBuf : public std::streambuf
+    {
+      public:
+        LineBuf(BinaryLogger &_logger) : logger(_logger) {}
+
+      protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+
+      private:
+        BinaryLogger &logger;
+        std::string line;
+    };
+
+    /** Get the id of a string, writing it to the file if it is new. */
+    uint32_t intern(const std::string &str);
+
+    /**
+     * Get the id of a format string. Format strings are almost always
+     * literals, so they are looked up by address before by content.
+     */
+    uint32_t internFormat(const char *fmt);
+
+    void writeMessage(Tick when, uint32_t name, uint32_t flag,
+                      uint32_t fmt, const uint8_t *args, uint32_t size);
+
+    /** Get space for a record of the given size in the mapped window. */
+    uint8_t *reserve(size_t size);
+
+    /** Map the window that starts at the given file offset. */
+    void map(size_t offset, size_t size);
+
+  protected:
+    UncontendedMutex mutex;
+
+    int fd;
+    std::string filename;
+
+    /** Mapped window and its offset in the file. */
+    uint8_t *window;
+    size_t windowOffset;
+    size_t windowSize;
+
+    /** Write position within the window. */
+    size_t pos;
+
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_map<const char *, uint32_t> formats;
+    std::vector<const std::string *> stringById;
+
+    LineBuf buf;
+    std::ostream stream;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
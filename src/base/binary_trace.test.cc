@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/bitunion.hh"
+#include "base/gtest/cur_tick_fake.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+struct Message
+{
+    Tick when;
+    std::string name;
+    std::string flag;
+    std::string fmt;
+    std::vector<uint8_t> args;
+};
+
+template <typename T>
+T
+get(const std::vector<uint8_t> &data, size_t &pos)
+{
+    T value;
+    memcpy(&value, &data[pos], sizeof(value));
+    pos += sizeof(value);
+    return value;
+}
+
+/** Read all messages of a trace, resolving string ids. */
+std::vector<Message>
+readTrace(const std::string &file)
+{
+    std::ifstream in(file, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+    EXPECT_GE(data.size(), 16u);
+    EXPECT_EQ(memcmp(data.data(), "gem5trce", 8), 0);
+
+    std::map<uint32_t, std::string> strings;
+    std::vector<Message> messages;
+    size_t pos = 16;
+    while (pos < data.size() && data[pos] != 0) {
+        const uint8_t kind = data[pos++];
+        if (kind == trace::BinaryLogger::StringRecord) {
+            const uint32_t id = get<uint32_t>(data, pos);
+            const uint32_t len = get<uint32_t>(data, pos);
+            strings[id].assign(data.begin() + pos, data.begin() + pos + len);
+            pos += len;
+        } else {
+            EXPECT_EQ(kind, trace::BinaryLogger::MessageRecord);
+            Message msg;
+            msg.when = get<uint64_t>(data, pos);
+            msg.name = strings.at(get<uint32_t>(data, pos));
+            msg.flag = strings.at(get<uint32_t>(data, pos));
+            msg.fmt = strings.at(get<uint32_t>(data, pos));
+            const uint32_t size = get<uint32_t>(data, pos);
+            msg.args.assign(data.begin() + pos, data.begin() + pos + size);
+            pos += size;
+            messages.push_back(msg);
+        }
+    }
+    return messages;
+}
+
+enum Plain { PlainValue = 0x1f };
+enum Wide : int16_t { WideValue = -2 };
+enum Letter : uint8_t { LetterValue = 'A' };
+enum class Named { Value };
+
+std::ostream &
+operator<<(std::ostream &os, Named)
+{
+    return os << "Named::Value";
+}
+
+BitUnion32(Word)
+    Bitfield<15, 8> high;
+EndBitUnion(Word)
+
+std::string
+tempFile()
+{
+    char name[] = "/tmp/binary_trace.test.XXXXXX";
+    close(mkstemp(name));
+    return name;
+}
+
+} // anonymous namespace
+
+/** Messages are recorded with their format and raw arguments. */
+TEST(BinaryTraceTest, RecordArgs)
+{
+    const std::string file = tempFile();
+    {
+        trace::BinaryLogger logger(file);
+        logger.dprintf_flag(100, "system.cpu", "Exec", "%#x %d %s %c\n",
+                            0x1234u, -5, "foo", 'z');
+        logger.dprintf(200, "system.mem", "No arguments\n");
+    }
+
+    auto messages = readTrace(file);
+    ASSERT_EQ(messages.size(), 2u);
+
+    const Message &msg = messages[0];
+    EXPECT_EQ(msg.when, 100u);
+    EXPECT_EQ(msg.name, "system.cpu");
+    EXPECT_EQ(msg.flag, "Exec");
+    EXPECT_EQ(msg.fmt, "%#x %d %s %c\n");
+
+    size_t pos = 0;
+    EXPECT_EQ(msg.args[pos++], trace::RecordArgs::UInt32);
+    EXPECT_EQ(get<uint32_t>(msg.args, pos), 0x1234u);
+    EXPECT_EQ(msg.args[pos++], trace::RecordArgs::Int32);
+    EXPECT_EQ(get<int32_t>(msg.args, pos), -5);
+    EXPECT_EQ(msg.args[pos++], trace::RecordArgs::String);
+    EXPECT_EQ(get<uint32_t>(msg.args, pos), 3u);
+    EXPECT_EQ(std::string(msg.args.begin() + pos,
+                          msg.args.begin() + pos + 3), "foo");
+    pos += 3;
+    EXPECT_EQ(msg.args[pos++], trace::RecordArgs::Char);
+    EXPECT_EQ(msg.args[pos++], (uint8_t)'z');
+    EXPECT_EQ(pos, msg.args.size());
+
+    EXPECT_EQ(messages[1].when, 200u);
+    EXPECT_EQ(messages[1].flag, "");
+    EXPECT_TRUE(messages[1].args.empty());
+    unlink(file.c_str());
+}
+
+/**
+ * Enums and BitUnions that are printed as numbers are recorded as
+ * integers, so that util/decode_binary_trace.py can apply %x to them.
+ */
+TEST(BinaryTraceTest, IntegerLikeArgs)
+{
+    const std::string file = tempFile();
+    const Word word = 0xabcd;
+    {
+        trace::BinaryLogger logger(file);
+        logger.dprintf_flag(1, "system", "Flag", "%#x %#x %#x %s %s\n",
+                            PlainValue, WideValue, word, LetterValue,
+                            Named::Value);
+    }
+
+    auto messages = readTrace(file);
+    ASSERT_EQ(messages.size(), 1u);
+    const std::vector<uint8_t> &args = messages[0].args;
+
+    size_t pos = 0;
+    EXPECT_EQ(args[pos++], trace::RecordArgs::Int32);
+    EXPECT_EQ(get<int32_t>(args, pos), 0x1f);
+    EXPECT_EQ(args[pos++], trace::RecordArgs::Int16);
+    EXPECT_EQ(get<int16_t>(args, pos), -2);
+    EXPECT_EQ(args[pos++], trace::RecordArgs::UInt32);
+    EXPECT_EQ(get<uint32_t>(args, pos), 0xabcdu);
+    // Streamed as a character, like cprintf does for any format
+    EXPECT_EQ(args[pos++], trace::RecordArgs::String);
+    EXPECT_EQ(get<uint32_t>(args, pos), 1u);
+    EXPECT_EQ(args[pos++], 'A');
+    // Printed with its own stream operator
+    EXPECT_EQ(args[pos++], trace::RecordArgs::String);
+    EXPECT_EQ(get<uint32_t>(args, pos), 12u);
+    EXPECT_EQ(std::string(args.begin() + pos, args.begin() + pos + 12),
+              "Named::Value");
+    pos += 12;
+    EXPECT_EQ(pos, args.size());
+    unlink(file.c_str());
+}
+
+/** Strings are only written once. */
+TEST(BinaryTraceTest, InternStrings)
+{
+    const std::string file = tempFile();
+    {
+        trace::BinaryLogger logger(file);
+        for (int i = 0; i < 100; ++i)
+            logger.dprintf_flag(i, "system.cpu", "Exec", "%d\n", i);
+    }
+
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    const size_t size = in.tellg();
+    // Header, three strings and 100 messages with one argument each
+    EXPECT_LT(size, 16u + 3 * 32 + 100 * (1 + 8 + 16 + 5));
+
+    auto messages = readTrace(file);
+    ASSERT_EQ(messages.size(), 100u);
+    EXPECT_EQ(messages[99].when, 99u);
+    EXPECT_EQ(messages[99].fmt, "%d\n");
+    unlink(file.c_str());
+}
+
+/** Text written to the ostream and dumps are recorded as strings. */
+TEST(BinaryTraceTest, TextMessages)
+{
+    const std::string file = tempFile();
+    {
+        trace::BinaryLogger logger(file);
+        logger.getOstream() << "Hello " << 42 << "\n";
+        const char data[] = "abc";
+        logger.dump(10, "system", data, 3, "Flag");
+    }
+
+    auto messages = readTrace(file);
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0].when, MaxTick);
+    EXPECT_EQ(messages[0].fmt, "%s");
+    EXPECT_EQ(std::string(messages[0].args.begin() + 5,
+                          messages[0].args.end()), "Hello 42\n");
+    EXPECT_EQ(messages[1].name, "system");
+    EXPECT_EQ(messages[1].flag, "Flag");
+    unlink(file.c_str());
+}
+
+/** Records that do not fit into the first window end up in the file. */
+TEST(BinaryTraceTest, GrowWindow)
+{
+    const std::string file = tempFile();
+    const std::string big(60000, 'x');
+    const size_t count =
+        trace::BinaryLogger::WindowSize / big.size() * 3 / 2;
+    {
+        trace::BinaryLogger logger(file);
+        for (size_t i = 0; i < count; ++i)
+            logger.dprintf(i, "system", "%s\n", big);
+    }
+
+    auto messages = readTrace(file);
+    ASSERT_EQ(messages.size(), count);
+    EXPECT_EQ(messages.back().when, count - 1);
+    EXPECT_EQ(messages.back().args.size(), 5 + big.size());
+    unlink(file.c_str());
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/pool_alloc.hh"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace gem5
+{
+
+namespace pool_alloc
+{
+
+namespace internal
+{
+
+namespace
+{
+
+/** Counters of all live threads and the totals of exited ones. */
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<Counters *> threads;
+    uint64_t exitedHits = 0;
+    uint64_t exitedMisses = 0;
+
+    uint64_t
+    sum(std::atomic<uint64_t> Counters::*counter, uint64_t Registry::*exited)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t total = this->*exited;
+        for (auto *c : threads)
+            total += (c->*counter).load(std::memory_order_relaxed);
+        return total;
+    }
+};
+
+/** Never destroyed, threads may exit after static destruction. */
+Registry &
+registry()
+{
+    static Registry *reg = new Registry;
+    return *reg;
+}
+
+/** Folds the counters of a thread into the totals when it exits. */
+struct Registration
+{
+    Registration()
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.threads.push_back(&counters);
+        counters.registered = true;
+    }
+
+    ~Registration()
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.exitedHits += counters.hits.load(std::memory_order_relaxed);
+        reg.exitedMisses += counters.misses.load(std::memory_order_relaxed);
+        reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(),
+                                    &counters));
+    }
+};
+
+} // anonymous namespace
+
+void
+registerThread()
+{
+    static thread_local Registration registration;
+    (void)registration;
+}
+
+/** Size of a slab, large enough to hold a few hundred packets. */
+static const size_t SlabSize = 64 * 1024;
+
+/** Minimum number of blocks per slab for very large blocks. */
+static const size_t MinBlocksPerSlab = 16;
+
+void *
+refill(size_t block_size, void *&free_list)
+{
+    const size_t num_blocks =
+        std::max(SlabSize / block_size, MinBlocksPerSlab);
+    char *slab = static_cast<char *>(::operator new(num_blocks * block_size));
+
+    // Hand out the first block and put the others on the free list
+    for (size_t i = num_blocks - 1; i > 0; --i) {
+        void *block = slab + i * block_size;
+        *static_cast<void **>(block) = free_list;
+        free_list = block;
+    }
+
+    return slab;
+}
+
+} // namespace internal
+
+uint64_t
+hits()
+{
+    return internal::registry().sum(&internal::Counters::hits,
+                                    &internal::Registry::exitedHits);
+}
+
+uint64_t
+misses()
+{
+    return internal::registry().sum(&internal::Counters::misses,
+                                    &internal::Registry::exitedMisses);
+}
+
+} // namespace pool_alloc
+
+} // namespace gem5
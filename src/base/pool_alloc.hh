@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Slab allocator for small objects that are allocated and freed at a
+ * high rate, such as packets and requests.
+ *
+ * Every block size gets its own pool. Each host thread keeps a private
+ * free list per pool, so allocation and deallocation never take a lock.
+ * A block may be freed by a different thread than the one that
+ * allocated it, in which case it simply joins the free list of the
+ * freeing thread. Slabs are never returned to the system.
+ */
+
+#ifndef __BASE_POOL_ALLOC_HH__
+#define __BASE_POOL_ALLOC_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace gem5
+{
+
+namespace pool_alloc
+{
+
+/** Number of allocations served from a free list, across all pools. */
+uint64_t hits();
+
+/** Number of allocations that required a new slab, across all pools. */
+uint64_t misses();
+
+namespace internal
+{
+
+/**
+ * Allocation counters of a host thread. They are only written by their
+ * own thread, without any atomic read-modify-write, and summed over all
+ * threads by hits() and misses().
+ */
+struct Counters
+{
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    bool registered = false;
+};
+
+inline thread_local Counters counters;
+
+/** Make the counters of the current thread visible to hits()/misses(). */
+void registerThread();
+
+inline void
+count(std::atomic<uint64_t> &counter)
+{
+    if (!counters.registered)
+        registerThread();
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+}
+
+/**
+ * Allocate a new slab of blocks of the given size, thread all but one
+ * of them onto the free list and return the remaining one.
+ */
+void *refill(size_t block_size, void *&free_list);
+
+} // namespace internal
+
+/**
+ * A pool of fixed size blocks.
+ *
+ * @tparam Size Size of a block in bytes.
+ * @tparam Align Required alignment of a block.
+ */
+template <size_t Size, size_t Align=alignof(std::max_align_t)>
+class FixedSizePool
+{
+  private:
+    static_assert(Align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "Over-aligned pools are not supported");
+
+    static constexpr size_t MinAlign =
+        Align > alignof(void *) ? Align : alignof(void *);
+    static constexpr size_t MinSize =
+        Size > sizeof(void *) ? Size : sizeof(void *);
+
+  public:
+    /** Size of the blocks handed out by this pool. */
+    static constexpr size_t BlockSize =
+        (MinSize + MinAlign - 1) / MinAlign * MinAlign;
+
+    static void *
+    allocate()
+    {
+        void *block = freeList;
+        if (block) {
+            freeList = *static_cast<void **>(block);
+            internal::count(internal::counters.hits);
+            return block;
+        }
+        internal::count(internal::counters.misses);
+        return internal::refill(BlockSize, freeList);
+    }
+
+    static void
+    deallocate(void *block)
+    {
+        *static_cast<void **>(block) = freeList;
+        freeList = block;
+    }
+
+  private:
+    /**
+     * Head of the free list of the current thread. This is a plain
+     * pointer so that it stays usable during static destruction.
+     */
+    static inline thread_local void *freeList = nullptr;
+};
+
+} // namespace pool_alloc
+
+/**
+ * Standard allocator backed by the pool allocator. Single object
+ * allocations come from a pool, arrays fall back to operator new. This
+ * makes it suitable for std::allocate_shared, which allocates the
+ * object and its control block as a single object.
+ */
+template <typename T>
+class PoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (n == 1) {
+            return static_cast<T *>(
+                pool_alloc::FixedSizePool<sizeof(T), alignof(T)>::allocate());
+        }
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        if (n == 1)
+            pool_alloc::FixedSizePool<sizeof(T), alignof(T)>::deallocate(p);
+        else
+            ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOC_HH__
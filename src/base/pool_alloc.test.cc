@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/pool_alloc.hh"
+
+using namespace gem5;
+
+/** Blocks are rounded up to hold at least a pointer and stay aligned. */
+TEST(PoolAllocTest, BlockSize)
+{
+    EXPECT_EQ((pool_alloc::FixedSizePool<1, 1>::BlockSize), sizeof(void *));
+    EXPECT_EQ((pool_alloc::FixedSizePool<24, 8>::BlockSize), 24u);
+    EXPECT_EQ((pool_alloc::FixedSizePool<24, 16>::BlockSize), 32u);
+}
+
+/** Freed blocks are reused and counted as hits. */
+TEST(PoolAllocTest, Reuse)
+{
+    typedef pool_alloc::FixedSizePool<40, 8> Pool;
+
+    void *first = Pool::allocate();
+    Pool::deallocate(first);
+
+    const uint64_t hits = pool_alloc::hits();
+    const uint64_t misses = pool_alloc::misses();
+    void *second = Pool::allocate();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pool_alloc::hits(), hits + 1);
+    EXPECT_EQ(pool_alloc::misses(), misses);
+    Pool::deallocate(second);
+}
+
+/** Live blocks never overlap and are suitably aligned. */
+TEST(PoolAllocTest, Distinct)
+{
+    typedef pool_alloc::FixedSizePool<48, 16> Pool;
+
+    std::set<uintptr_t> blocks;
+    std::vector<void *> live;
+    for (int i = 0; i < 10000; ++i) {
+        void *block = Pool::allocate();
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(block);
+        EXPECT_EQ(addr % 16, 0u);
+        auto it = blocks.lower_bound(addr);
+        if (it != blocks.end()) {
+            EXPECT_GE(*it, addr + Pool::BlockSize);
+        }
+        if (it != blocks.begin()) {
+            EXPECT_LE(*std::prev(it) + Pool::BlockSize, addr);
+        }
+        blocks.insert(addr);
+        live.push_back(block);
+    }
+    EXPECT_GT(pool_alloc::misses(), 0u);
+
+    for (auto *block : live)
+        Pool::deallocate(block);
+}
+
+/** Blocks can be freed by a different thread than the allocating one. */
+TEST(PoolAllocTest, CrossThread)
+{
+    typedef pool_alloc::FixedSizePool<32> Pool;
+
+    std::vector<void *> blocks;
+    std::thread producer([&blocks]() {
+        for (int i = 0; i < 1000; ++i)
+            blocks.push_back(Pool::allocate());
+    });
+    producer.join();
+
+    for (auto *block : blocks)
+        Pool::deallocate(block);
+
+    // The freed blocks are now on this thread's free list
+    std::set<void *> freed(blocks.begin(), blocks.end());
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(freed.count(Pool::allocate()), 1u);
+}
+
+/** Counters of other threads are included, also after they exit. */
+TEST(PoolAllocTest, ThreadCounters)
+{
+    typedef pool_alloc::FixedSizePool<56> Pool;
+
+    const uint64_t hits = pool_alloc::hits();
+    const uint64_t misses = pool_alloc::misses();
+    std::thread worker([]() {
+        // The first allocation of a thread always needs a new slab
+        void *block = Pool::allocate();
+        Pool::deallocate(block);
+        for (int i = 0; i < 100; ++i)
+            Pool::deallocate(Pool::allocate());
+    });
+    worker.join();
+
+    EXPECT_EQ(pool_alloc::hits(), hits + 100);
+    EXPECT_EQ(pool_alloc::misses(), misses + 1);
+}
+
+/** PoolAllocator works with std::allocate_shared. */
+TEST(PoolAllocTest, AllocateShared)
+{
+    struct Object
+    {
+        Object(int _a, int _b) : a(_a), b(_b) {}
+        int a;
+        int b;
+    };
+
+    std::weak_ptr<Object> weak;
+    {
+        auto obj = std::allocate_shared<Object>(PoolAllocator<Object>(), 1, 2);
+        EXPECT_EQ(obj->a, 1);
+        EXPECT_EQ(obj->b, 2);
+        weak = obj;
+        EXPECT_FALSE(weak.expired());
+    }
+    EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <zlib.h>
+
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/byteswap.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+template <typename T>
+void
+put(std::vector<uint8_t> &buf, T value)
+{
+    value = htole(value);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(value));
+}
+
+void
+putDouble(std::vector<uint8_t> &buf, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put(buf, bits);
+}
+
+void
+putString(std::vector<uint8_t> &buf, const std::string &str)
+{
+    const uint16_t len = std::min<size_t>(str.size(), UINT16_MAX);
+    put(buf, len);
+    buf.insert(buf.end(), str.begin(), str.begin() + len);
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(const std::string &file, bool _compress, bool desc,
+                   bool formulas)
+    : stream(file, std::ios::binary | std::ios::trunc),
+      compress(_compress), enableDescriptions(desc),
+      enableFormula(formulas), numColumns(0), schemaChanged(true)
+{
+    fatal_if(!stream, "Unable to open statistics file '%s' for writing\n",
+             file);
+
+    std::vector<uint8_t> header = {
+        'g', 'e', 'm', '5', 'c', 'o', 'l', 's' };
+    put(header, Version);
+    put(header, compress ? FlagCompressed : 0u);
+    stream.write((const char *)header.data(), header.size());
+}
+
+void
+Columnar::begin()
+{
+    path.clear();
+    pathLength.clear();
+    numColumns = 0;
+    values.clear();
+}
+
+void
+Columnar::end()
+{
+    if (numColumns != columns.size()) {
+        columns.resize(numColumns);
+        schemaChanged = true;
+    }
+
+    if (schemaChanged) {
+        buffer.clear();
+        put(buffer, (uint32_t)columns.size());
+        for (const auto &column : columns) {
+            putString(buffer, column.name);
+            putString(buffer, column.desc);
+        }
+        writeRecord(SchemaRecord, buffer);
+
+        // The next row is relative to an empty row
+        lastValues.assign(columns.size(), 0.0);
+        schemaChanged = false;
+    }
+
+    buffer.clear();
+    put(buffer, (uint64_t)curTick());
+    if (compress) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            uint64_t cur, last;
+            memcpy(&cur, &values[i], sizeof(cur));
+            memcpy(&last, &lastValues[i], sizeof(last));
+            put(buffer, cur ^ last);
+        }
+
+        uLongf size = compressBound(buffer.size());
+        compressed.resize(size);
+        if (compress2(compressed.data(), &size, buffer.data(),
+                      buffer.size(), Z_BEST_SPEED) != Z_OK) {
+            panic("Failed to compress statistics row\n");
+        }
+        compressed.resize(size);
+        writeRecord(CompressedRowRecord, compressed);
+        lastValues.swap(values);
+    } else {
+        for (auto value : values)
+            putDouble(buffer, value);
+        writeRecord(RowRecord, buffer);
+    }
+
+    stream.flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream.good();
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    pathLength.push_back(path.size());
+    if (!path.empty())
+        path += '.';
+    path += name;
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!pathLength.empty());
+    path.resize(pathLength.back());
+    pathLength.pop_back();
+}
+
+template <typename F>
+void
+Columnar::addColumn(const Info &info, unsigned element, Result value,
+                    F &&suffix)
+{
+    values.push_back(value);
+
+    const size_t index = numColumns++;
+    if (index < columns.size() && columns[index].info == &info &&
+        columns[index].element == element) {
+        return;
+    }
+
+    if (index >= columns.size())
+        columns.resize(index + 1);
+
+    Column &column = columns[index];
+    column.info = &info;
+    column.element = element;
+    column.name = path.empty() ? info.name : path + "." + info.name;
+    column.name += suffix();
+    column.desc = enableDescriptions ? info.desc : "";
+    schemaChanged = true;
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    addColumn(info, 0, info.result(), []() { return std::string(); });
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+    for (unsigned i = 0; i < result.size(); ++i) {
+        addColumn(info, i, result[i], [&]() {
+            const bool named = i < info.subnames.size() &&
+                !info.subnames[i].empty();
+            return info.separatorString +
+                (named ? info.subnames[i] : std::to_string(i));
+        });
+    }
+}
+
+void
+Columnar::addDist(const Info &info, unsigned first, const DistData &data,
+                  const std::string &prefix)
+{
+    unsigned element = first;
+    auto field = [&](const char *name, Result value) {
+        addColumn(info, element++, value, [&]() {
+            return prefix + info.separatorString + name;
+        });
+    };
+
+    field("samples", data.samples);
+    field("sum", data.sum);
+    field("squares", data.squares);
+    if (data.type == Deviation)
+        return;
+
+    field("min_value", data.min_val);
+    field("max_value", data.max_val);
+    field("underflows", data.underflow);
+    field("overflows", data.overflow);
+    if (data.type == Hist)
+        field("logs", data.logs);
+
+    for (unsigned i = 0; i < data.cvec.size(); ++i) {
+        addColumn(info, element++, data.cvec[i], [&]() {
+            const Counter low = data.min + i * data.bucket_size;
+            return prefix + info.separatorString +
+                csprintf("%g-%g", low, low + data.bucket_size - 1);
+        });
+    }
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    addDist(info, 0, info.data, "");
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    // Elements are far apart so that every field has a unique number
+    for (unsigned i = 0; i < info.size(); ++i) {
+        const bool named = i < info.subnames.size() &&
+            !info.subnames[i].empty();
+        addDist(info, i << 16, info.data[i], info.separatorString +
+                (named ? info.subnames[i] : std::to_string(i)));
+    }
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    for (unsigned x = 0; x < info.x; ++x) {
+        for (unsigned y = 0; y < info.y; ++y) {
+            const unsigned i = x * info.y + y;
+            addColumn(info, i, info.cvec[i], [&]() {
+                const bool x_named = x < info.subnames.size() &&
+                    !info.subnames[x].empty();
+                const bool y_named = y < info.y_subnames.size() &&
+                    !info.y_subnames[y].empty();
+                return info.separatorString +
+                    (x_named ? info.subnames[x] : std::to_string(x)) +
+                    info.separatorString +
+                    (y_named ? info.y_subnames[y] : std::to_string(y));
+            });
+        }
+    }
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    if (enableFormula)
+        visit((const VectorInfo &)info);
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    // The buckets of a sparse histogram change from dump to dump, only
+    // keep the number of samples
+    addColumn(info, 0, info.data.samples, [&]() {
+        return info.separatorString + "samples";
+    });
+}
+
+void
+Columnar::writeRecord(RecordKind kind, const std::vector<uint8_t> &payload)
+{
+    const uint32_t size = htole((uint32_t)payload.size());
+    char header[1 + sizeof(size)] = { (char)kind };
+    memcpy(header + 1, &size, sizeof(size));
+    stream.write(header, sizeof(header));
+    stream.write((const char *)payload.data(), payload.size());
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool compress, bool desc,
+             bool formulas)
+{
+    return std::unique_ptr<Output>(
+        new Columnar(simout.resolve(filename), compress, desc, formulas));
+}
+
+} // namespace statistics
+} // namespace gem5
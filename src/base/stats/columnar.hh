@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary columnar statistics output.
+ *
+ * The file starts with a header and is followed by a sequence of
+ * records. A schema record lists the name, and optionally the
+ * description, of every column. It is only written for the first dump
+ * and whenever the set of stats changes. Every dump then appends a row
+ * record holding the current tick and one double per column. Rows can
+ * optionally be compressed, in which case each row is XORed with the
+ * previous one before being deflated, so that stats that did not
+ * change cost next to nothing.
+ *
+ * All values are little endian:
+ *
+ *   header:  char magic[8] = "gem5cols", uint32 version, uint32 flags
+ *   record:  uint8 kind, uint32 payload size, payload
+ *   schema:  uint32 columns, then per column
+ *            uint16 length, name, uint16 length, description
+ *   row:     uint64 tick, double values[columns]
+ *
+ * m5.stats.columnar provides a reader for this format.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Columnar : public Output
+{
+  public:
+    /** Record kinds. */
+    enum RecordKind : uint8_t
+    {
+        SchemaRecord = 'S',
+        RowRecord = 'R',
+        CompressedRowRecord = 'Z',
+    };
+
+    /** Header flags. */
+    static constexpr uint32_t FlagCompressed = 0x1;
+
+    static constexpr uint32_t Version = 1;
+
+    Columnar(const std::string &file, bool compress, bool desc,
+             bool formulas);
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /**
+     * A column is identified by the stat it belongs to and the index
+     * of the value within that stat, which lets a dump check that the
+     * schema is unchanged without building any names.
+     */
+    struct Column
+    {
+        const Info *info;
+        unsigned element;
+        std::string name;
+        std::string desc;
+    };
+
+    /**
+     * Add the value of the next column. The name of the column is only
+     * built, by calling suffix(), if it differs from the schema.
+     */
+    template <typename F>
+    void addColumn(const Info &info, unsigned element, Result value,
+                   F &&suffix);
+
+    /** Add the columns of a distribution. */
+    void addDist(const Info &info, unsigned first, const DistData &data,
+                 const std::string &prefix);
+
+    void writeRecord(RecordKind kind, const std::vector<uint8_t> &payload);
+
+  protected:
+    std::ofstream stream;
+    const bool compress;
+    const bool enableDescriptions;
+    const bool enableFormula;
+
+    /** Group path of the stat being visited and the length per level. */
+    std::string path;
+    std::vector<size_t> pathLength;
+
+    /** Columns of the last schema record and of the current dump. */
+    std::vector<Column> columns;
+    size_t numColumns;
+    bool schemaChanged;
+
+    /** Values of the current and previous dump. */
+    std::vector<Result> values;
+    std::vector<Result> lastValues;
+
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> compressed;
+};
+
+std::unique_ptr<Output> initColumnar(
+    const std::string &filename, bool compress = true,
+    bool desc = true, bool formulas = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
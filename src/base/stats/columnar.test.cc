@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    TestScalar(const std::string &_name)
+    {
+        setName(_name, false);
+        desc = "A test scalar";
+        flags.set(statistics::display);
+    }
+
+    double value_ = 0;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { value_ = 0; }
+    bool zero() const override { return value_ == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return value_; }
+    statistics::Result result() const override { return value_; }
+    statistics::Result total() const override { return value_; }
+};
+
+struct Record
+{
+    char kind;
+    std::vector<uint8_t> payload;
+};
+
+/** Read all records of a file, decompressing rows. */
+std::vector<Record>
+readRecords(const std::string &file)
+{
+    std::ifstream in(file, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+    EXPECT_GE(data.size(), 16u);
+    EXPECT_EQ(memcmp(data.data(), "gem5cols", 8), 0);
+
+    std::vector<Record> records;
+    size_t pos = 16;
+    while (pos < data.size()) {
+        Record record;
+        uint32_t size;
+        record.kind = data[pos];
+        memcpy(&size, &data[pos + 1], sizeof(size));
+        record.payload.assign(data.begin() + pos + 5,
+                              data.begin() + pos + 5 + size);
+        pos += 5 + size;
+
+        if (record.kind == statistics::Columnar::CompressedRowRecord) {
+            std::vector<uint8_t> raw(1 << 16);
+            uLongf len = raw.size();
+            EXPECT_EQ(uncompress(raw.data(), &len, record.payload.data(),
+                                 record.payload.size()), Z_OK);
+            raw.resize(len);
+            record.payload = raw;
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+uint64_t
+word(const Record &record, size_t index)
+{
+    uint64_t value;
+    memcpy(&value, &record.payload[index * 8], sizeof(value));
+    return value;
+}
+
+double
+column(const Record &record, size_t index)
+{
+    uint64_t bits = word(record, index + 1);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string
+tempFile()
+{
+    char name[] = "/tmp/columnar.test.XXXXXX";
+    close(mkstemp(name));
+    return name;
+}
+
+void
+dump(statistics::Output &output, std::vector<TestScalar *> stats)
+{
+    output.begin();
+    output.beginGroup("system");
+    for (auto *stat : stats)
+        stat->visit(output);
+    output.endGroup();
+    output.end();
+}
+
+} // anonymous namespace
+
+/** The schema is written once, followed by one row per dump. */
+TEST(StatsColumnarTest, SchemaOnce)
+{
+    const std::string file = tempFile();
+    TestScalar a("a"), b("b");
+    {
+        statistics::Columnar output(file, false, true, true);
+        for (int i = 0; i < 3; ++i) {
+            a.value_ = i;
+            b.value_ = 10 * i;
+            dump(output, {&a, &b});
+        }
+    }
+
+    auto records = readRecords(file);
+    ASSERT_EQ(records.size(), 4u);
+    ASSERT_EQ(records[0].kind, statistics::Columnar::SchemaRecord);
+    const std::string schema(records[0].payload.begin(),
+                             records[0].payload.end());
+    EXPECT_NE(schema.find("system.a"), std::string::npos);
+    EXPECT_NE(schema.find("A test scalar"), std::string::npos);
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(records[i + 1].kind, statistics::Columnar::RowRecord);
+        ASSERT_EQ(records[i + 1].payload.size(), 3 * 8u);
+        EXPECT_EQ(column(records[i + 1], 0), i);
+        EXPECT_EQ(column(records[i + 1], 1), 10 * i);
+    }
+    unlink(file.c_str());
+}
+
+/** Compressed rows are XORed with the previous row. */
+TEST(StatsColumnarTest, CompressedDelta)
+{
+    const std::string file = tempFile();
+    TestScalar a("a"), b("b");
+    {
+        statistics::Columnar output(file, true, false, true);
+        a.value_ = 1;
+        b.value_ = 2;
+        dump(output, {&a, &b});
+        a.value_ = 3;
+        dump(output, {&a, &b});
+    }
+
+    auto records = readRecords(file);
+    ASSERT_EQ(records.size(), 3u);
+    ASSERT_EQ(records[1].kind, statistics::Columnar::CompressedRowRecord);
+    EXPECT_EQ(column(records[1], 0), 1.0);
+    EXPECT_EQ(column(records[1], 1), 2.0);
+
+    // Unchanged values are all zero
+    ASSERT_EQ(records[2].kind, statistics::Columnar::CompressedRowRecord);
+    EXPECT_NE(word(records[2], 1), 0u);
+    EXPECT_EQ(word(records[2], 2), 0u);
+    unlink(file.c_str());
+}
+
+/** A new schema is written when the set of stats changes. */
+TEST(StatsColumnarTest, SchemaChange)
+{
+    const std::string file = tempFile();
+    TestScalar a("a"), b("b");
+    {
+        statistics::Columnar output(file, false, false, true);
+        dump(output, {&a});
+        dump(output, {&a});
+        dump(output, {&a, &b});
+        dump(output, {&a, &b});
+    }
+
+    auto records = readRecords(file);
+    ASSERT_EQ(records.size(), 6u);
+    EXPECT_EQ(records[0].kind, statistics::Columnar::SchemaRecord);
+    EXPECT_EQ(records[3].kind, statistics::Columnar::SchemaRecord);
+    EXPECT_EQ(records[5].payload.size(), 3 * 8u);
+    unlink(file.c_str());
+}
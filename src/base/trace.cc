@@ -103,6 +103,19 @@ disable()
 
 ObjectMatch ignore;
 
+RecordArgs &
+threadRecordArgs()
+{
+    static thread_local RecordArgs args;
+    return args;
+}
+
+void
+Logger::logRecord(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const RecordArgs &args)
+{
+    panic("Logger does not support unformatted messages\n");
+}
 
 void
 Logger::dump(Tick when, const std::string &name,
@@ -41,6 +41,7 @@
 #include "base/debug.hh"
 #include "base/logging.hh"
 #include "base/match.hh"
+#include "base/trace_record.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
 
@@ -64,6 +65,12 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /**
+     * If set, messages are passed unformatted to logRecord() instead
+     * of being formatted and passed to logMessage().
+     */
+    bool recordArgs = false;
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,6 +103,13 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (recordArgs) {
+            RecordArgs &record = threadRecordArgs();
+            record.clear();
+            (record.add(args), ...);
+            logRecord(when, name, flag, fmt, record);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -109,6 +123,11 @@ class Logger
     virtual void logMessage(Tick when, const std::string &name,
             const std::string &flag, const std::string &message) = 0;
 
+    /** Log an unformatted message, only used if recordArgs is set */
+    virtual void logRecord(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            const RecordArgs &args);
+
     /** Return an ostream that can be used to send messages to
      *  the 'same place' as formatted logMessage messages.  This
      *  can be implemented to use a logger's underlying ostream,
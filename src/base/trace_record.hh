@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_RECORD_HH__
+#define __BASE_TRACE_RECORD_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gem5
+{
+
+namespace bitfield_backend
+{
+template <class Base>
+class BitUnionOperators;
+} // namespace bitfield_backend
+
+namespace trace
+{
+
+namespace internal
+{
+
+/**
+ * Stand-ins for the integer overloads of the stream operators. Overload
+ * resolution picks the one a value is printed with, e.g. the promoted
+ * type of an enum or the storage type of a BitUnion.
+ */
+short streamedAs(short);
+unsigned short streamedAs(unsigned short);
+int streamedAs(int);
+unsigned streamedAs(unsigned);
+long streamedAs(long);
+unsigned long streamedAs(unsigned long);
+long long streamedAs(long long);
+unsigned long long streamedAs(unsigned long long);
+char streamedAs(char);
+signed char streamedAs(signed char);
+unsigned char streamedAs(unsigned char);
+
+/**
+ * Selected for enums without a stream operator of their own, which are
+ * therefore printed as integers. An operator taking the enum itself is
+ * preferred over this template, while the integer overloads of the
+ * stream need a promotion and are not.
+ */
+struct NoStreamOperator {};
+template <typename T, typename = std::enable_if_t<std::is_enum_v<T>>>
+NoStreamOperator operator<<(std::ostream &, T);
+
+template <typename T, typename = void>
+struct PrintedAsInteger : std::false_type {};
+
+template <typename T>
+struct PrintedAsInteger<T, std::enable_if_t<std::is_same_v<
+    decltype(operator<<(std::declval<std::ostream &>(),
+                        std::declval<const T &>())),
+    NoStreamOperator>>>
+{
+    using Type = decltype(streamedAs(std::declval<const T &>()));
+    // Enums with a character as underlying type are printed as one
+    static constexpr bool value = sizeof(Type) > 1;
+};
+
+/** BitUnions are printed as their storage type. */
+template <typename Base>
+struct PrintedAsInteger<bitfield_backend::BitUnionOperators<Base>>
+{
+    using Type = decltype(streamedAs(
+        std::declval<const bitfield_backend::BitUnionOperators<Base> &>()));
+    // Which operator prints a character depends on the includes
+    static constexpr bool value = sizeof(Type) > 1;
+};
+
+} // namespace internal
+
+/**
+ * The raw arguments of a debug message. Loggers that support deferred
+ * formatting record these instead of the formatted message.
+ *
+ * Integers, characters, floating point numbers, pointers and strings
+ * are stored as such, each preceded by its type. Enums and BitUnions
+ * that are printed as numbers are stored as the integer type the
+ * stream operator prints them as, so that format flags such as %#x
+ * still apply to them. Any other type is converted to a string using
+ * its stream operator, which means that format flags only pad it when
+ * the message is eventually formatted.
+ */
+class RecordArgs
+{
+  public:
+    /**
+     * Argument types. Where possible, these match the format
+     * characters of Python's struct module.
+     */
+    enum Type : uint8_t
+    {
+        Int16 = 'h',
+        UInt16 = 'H',
+        Int32 = 'i',
+        UInt32 = 'I',
+        Int64 = 'q',
+        UInt64 = 'Q',
+        Double = 'd',
+        Char = 'c',
+        UChar = 'C',
+        Bool = '?',
+        Pointer = 'P',
+        /** uint32 length followed by the characters */
+        String = 's',
+    };
+
+    /** Strings longer than this are truncated. */
+    static constexpr uint32_t MaxStringSize = 64 * 1024;
+
+    void
+    clear()
+    {
+        buffer.clear();
+        count = 0;
+    }
+
+    const uint8_t *data() const { return buffer.data(); }
+    size_t size() const { return buffer.size(); }
+    unsigned numArgs() const { return count; }
+
+    template <typename T>
+    void
+    add(const T &arg)
+    {
+        ++count;
+        addValue(arg);
+    }
+
+  private:
+    template <typename T>
+    void
+    addValue(const T &arg)
+    {
+        constexpr bool is_signed = std::is_signed_v<T>;
+        if constexpr (std::is_same_v<T, bool>) {
+            put(Bool, (uint8_t)arg);
+        } else if constexpr (std::is_same_v<T, char> ||
+                             std::is_same_v<T, signed char>) {
+            put(Char, (int8_t)arg);
+        } else if constexpr (std::is_same_v<T, unsigned char>) {
+            put(UChar, (uint8_t)arg);
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) == 2) {
+            put(is_signed ? Int16 : UInt16, arg);
+        } else if constexpr (std::is_integral_v<T> && sizeof(T) == 4) {
+            put(is_signed ? Int32 : UInt32, arg);
+        } else if constexpr (std::is_integral_v<T> && is_signed) {
+            put(Int64, (int64_t)arg);
+        } else if constexpr (std::is_integral_v<T>) {
+            put(UInt64, (uint64_t)arg);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            put(Double, (double)arg);
+        } else if constexpr (std::is_array_v<T> &&
+                             std::is_same_v<std::remove_cv_t<
+                                 std::remove_extent_t<T>>, char>) {
+            putString(arg, strnlen(arg, std::extent_v<T>));
+        } else if constexpr (std::is_same_v<T, const char *> ||
+                             std::is_same_v<T, char *>) {
+            if (arg)
+                putString(arg, strlen(arg));
+            else
+                putString("(null)", 6);
+        } else if constexpr (std::is_pointer_v<T>) {
+            put(Pointer, (uint64_t)(uintptr_t)arg);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            putString(arg.data(), arg.size());
+        } else if constexpr (internal::PrintedAsInteger<T>::value) {
+            addValue(
+                static_cast<typename internal::PrintedAsInteger<T>::Type>(
+                    arg));
+        } else {
+            std::ostringstream str;
+            str << arg;
+            const std::string s = str.str();
+            putString(s.data(), s.size());
+        }
+    }
+
+    template <typename V>
+    void
+    put(Type type, V value)
+    {
+        const size_t pos = buffer.size();
+        buffer.resize(pos + 1 + sizeof(value));
+        buffer[pos] = type;
+        memcpy(&buffer[pos + 1], &value, sizeof(value));
+    }
+
+    void
+    putString(const char *str, size_t len)
+    {
+        const uint32_t size = len < MaxStringSize ? len : MaxStringSize;
+        put(String, size);
+        buffer.insert(buffer.end(), str, str + size);
+    }
+
+    std::vector<uint8_t> buffer;
+    unsigned count = 0;
+};
+
+/** Per-thread argument buffer used while recording a message. */
+RecordArgs &threadRecordArgs();
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_TRACE_RECORD_HH__
@@ -29,10 +29,12 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <array>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -127,6 +129,14 @@ class AddrMap
         recent[0] = recent[1] = chunkMap.end();
     }
 
+    AddrMap(const AddrMap &other) = delete;
+
+    ~AddrMap()
+    {
+        for (auto &chunk: chunkMap)
+            delete chunk.second;
+    }
+
     Value &
     lookup(Addr addr)
     {
@@ -135,6 +145,67 @@ class AddrMap
     }
 };
 
+/// A small direct-mapped cache of recently decoded instructions which
+/// is checked before the decode maps. An entry only hits if both the
+/// address and the machine instruction match, so modified code is
+/// never returned from it.
+template <typename EMI, typename Value = StaticInstPtr,
+          unsigned IndexBits = 10>
+class Lookaside
+{
+  public:
+    static constexpr size_t Size = 1ULL << IndexBits;
+
+  protected:
+    struct Entry
+    {
+        bool valid = false;
+        Addr addr = 0;
+        EMI machInst = {};
+        Value value = {};
+    };
+    std::array<Entry, Size> entries;
+
+    static size_t
+    index(Addr addr)
+    {
+        // Fold in the next higher bits so that 4 byte aligned
+        // instructions use all entries and code at the same offset
+        // in different pages does not conflict.
+        return ((addr >> 1) ^ (addr >> (IndexBits + 1))) & (Size - 1);
+    }
+
+  public:
+    /// Look up the value for a machine instruction at an address.
+    /// @retval A pointer to the value or nullptr if there is none.
+    Value *
+    find(Addr addr, const EMI &mach_inst)
+    {
+        Entry &entry = entries[index(addr)];
+        if (entry.valid && entry.addr == addr &&
+                entry.machInst == mach_inst) {
+            return &entry.value;
+        }
+        return nullptr;
+    }
+
+    void
+    insert(Addr addr, const EMI &mach_inst, const Value &value)
+    {
+        Entry &entry = entries[index(addr)];
+        entry.valid = true;
+        entry.addr = addr;
+        entry.machInst = mach_inst;
+        entry.value = value;
+    }
+
+    void
+    clear()
+    {
+        entries.fill(Entry());
+    }
+};
+
 } // namespace decode_cache
 } // namespace gem5
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+/** Entries are kept per address and survive lookups of other chunks. */
+TEST(DecodeCacheTest, AddrMapLookup)
+{
+    decode_cache::AddrMap<int> map;
+    map.lookup(0x1000) = 1;
+    map.lookup(0x2004) = 2;
+    map.lookup(0x3008) = 3;
+
+    EXPECT_EQ(map.lookup(0x1000), 1);
+    EXPECT_EQ(map.lookup(0x2004), 2);
+    EXPECT_EQ(map.lookup(0x3008), 3);
+    EXPECT_EQ(map.lookup(0x3004), 0);
+}
+
+/** The lookaside only hits if both address and instruction match. */
+TEST(DecodeCacheTest, LookasideFind)
+{
+    decode_cache::Lookaside<uint32_t, int, 4> lookaside;
+    EXPECT_EQ(lookaside.find(0x1000, 0xaa), nullptr);
+
+    lookaside.insert(0x1000, 0xaa, 1);
+    ASSERT_NE(lookaside.find(0x1000, 0xaa), nullptr);
+    EXPECT_EQ(*lookaside.find(0x1000, 0xaa), 1);
+
+    // Modified code misses
+    EXPECT_EQ(lookaside.find(0x1000, 0xbb), nullptr);
+    // An address with the same index misses
+    EXPECT_EQ(lookaside.find(0x1200, 0xaa), nullptr);
+
+    // Conflicting addresses replace each other
+    lookaside.insert(0x1200, 0xaa, 2);
+    EXPECT_EQ(lookaside.find(0x1000, 0xaa), nullptr);
+    ASSERT_NE(lookaside.find(0x1200, 0xaa), nullptr);
+
+    lookaside.insert(0x1004, 0xcc, 3);
+    lookaside.clear();
+    EXPECT_EQ(lookaside.find(0x1004, 0xcc), nullptr);
+}
+
+/** Consecutive 2 and 4 byte aligned instructions use different entries. */
+TEST(DecodeCacheTest, LookasideIndex)
+{
+    decode_cache::Lookaside<uint32_t, int, 4> lookaside;
+    for (int i = 0; i < 16; ++i)
+        lookaside.insert(0x1000 + 4 * i, i, i);
+    for (int i = 0; i < 16; ++i)
+        EXPECT_NE(lookaside.find(0x1000 + 4 * i, i), nullptr);
+
+    lookaside.clear();
+    for (int i = 0; i < 16; ++i)
+        lookaside.insert(0x1000 + 2 * i, i, i);
+    for (int i = 0; i < 16; ++i)
+        EXPECT_NE(lookaside.find(0x1000 + 2 * i, i), nullptr);
+}
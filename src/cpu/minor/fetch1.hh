@@ -182,7 +182,7 @@ class Fetch1 : public Named
             pc(pc_),
             fault(NoFault)
         {
-            request = std::make_shared<Request>();
+            request = Request::create();
         }
 
         ~FetchRequest();
@@ -61,6 +61,13 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    block_cache = Param.Bool(
+        False,
+        "Cache decoded basic blocks and execute cycles back to back while "
+        "no events are due, e.g., for fast-forwarding. Blocks are only "
+        "cached for instruction memory with a back door, i.e., without "
+        "instruction caches.",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
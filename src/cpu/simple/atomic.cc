@@ -52,6 +52,7 @@
 #include "mem/packet_access.hh"
 #include "mem/physical.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
+#include "sim/async.hh"
 #include "sim/faults.hh"
 #include "sim/full_system.hh"
 #include "sim/system.hh"
@@ -84,10 +85,22 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
+
+    if (p.block_cache) {
+        fatal_if(simulate_inst_stalls,
+                 "%s: Instruction stalls can't be simulated with the "
+                 "block cache.", name());
+        for (ThreadID tid = 0; tid < numThreads; tid++) {
+            blockCaches.emplace_back(new DecodedBlockCache(
+                [this](Addr paddr, Addr size) {
+                    return fetchHostPtr(paddr, size);
+                }));
+        }
+    }
 }
 
 
@@ -196,6 +209,11 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
+
+    // Another CPU may change the decoder state and memory until this
+    // one is switched back in
+    for (auto &cache : blockCaches)
+        cache->clear();
 }
 
 
@@ -500,6 +518,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                         req->localAccessor(thread->getTC(), &pkt);
                 } else {
                     dcache_latency += sendPacket(dcachePort, &pkt);
+                    invalidateBlocks(req->getPaddr(), req->getSize());
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
@@ -590,6 +609,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateBlocks(req->getPaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -609,6 +629,34 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
 
 void
 AtomicSimpleCPU::tick()
+{
+    // Other events may have modified memory since the last cycle, so
+    // blocks have to be checked again before they are used
+    for (auto &cache : blockCaches)
+        cache->leave();
+
+    for (unsigned cycles = 1; ; cycles++) {
+        const Tick latency = tickCycle();
+        if (!latency)
+            return;
+
+        // If no event is due before the next cycle, nothing else can
+        // happen in the meantime, so run the next cycle right away.
+        const Tick next = curTick() + latency;
+        if (!blockCaches.empty() && cycles < MaxBackToBackCycles &&
+                !async_event &&
+                (eventQueue()->empty() || eventQueue()->nextTick() > next)) {
+            eventQueue()->setCurTick(next);
+            continue;
+        }
+
+        reschedule(tickEvent, next, true);
+        return;
+    }
+}
+
+Tick
+AtomicSimpleCPU::tickCycle()
 {
     DPRINTF(SimpleCPU, "Tick\n");
 
@@ -642,7 +690,7 @@ AtomicSimpleCPU::tick()
         // We must have just got suspended by a PC event
         if (_status == Idle) {
             tryCompleteDrain();
-            return;
+            return 0;
         }
 
         serviceInstCountEvents();
@@ -650,6 +698,9 @@ AtomicSimpleCPU::tick()
         Fault fault = NoFault;
 
         const PCStateBase &pc = thread->pcState();
+        DecodedBlockCache *block_cache =
+            blockCaches.empty() ? nullptr : blockCaches[curThread].get();
+        const DecodedBlockCache::Inst *cached = nullptr;
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
         if (needToFetch) {
@@ -657,6 +708,13 @@ AtomicSimpleCPU::tick()
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseMMU::Execute);
+
+            // Cached instructions are found by the translated address,
+            // so that they follow any change of the address space
+            if (fault == NoFault && block_cache && !t_info.stayAtPC) {
+                cached = block_cache->find(pc, thread->decoder->context(),
+                        ifetch_req->getVaddr(), ifetch_req->getPaddr());
+            }
         }
 
         if (fault == NoFault) {
@@ -664,7 +722,7 @@ AtomicSimpleCPU::tick()
             bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
-            if (needToFetch) {
+            if (needToFetch && !cached) {
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -675,9 +733,30 @@ AtomicSimpleCPU::tick()
                     icache_access = true;
                     icache_latency = fetchInstMem();
                 //}
+
+                if (block_cache) {
+                    block_cache->recordFetch(ifetch_req->getVaddr(),
+                            ifetch_req->getPaddr(), ifetch_req->getSize(),
+                            (const uint8_t *)thread->decoder->moreBytesPtr());
+                }
             }
 
-            preExecute();
+            if (cached) {
+                thread->pcState(*cached->decodedPC);
+                preExecute(cached->inst);
+            } else if (needToFetch && block_cache) {
+                set(fetchPC, pc);
+                preExecute();
+                if (!t_info.stayAtPC) {
+                    const StaticInstPtr &inst = curMacroStaticInst ?
+                        curMacroStaticInst : curStaticInst;
+                    block_cache->recordInst(*fetchPC, thread->pcState(),
+                            inst, thread->decoder->context(),
+                            DecodedBlockCache::endsBlock(inst));
+                }
+            } else {
+                preExecute();
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -723,19 +802,57 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        if (fault != NoFault && block_cache)
+            block_cache->endBlock();
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
 
     if (tryCompleteDrain())
-        return;
+        return 0;
 
     // instruction takes at least one cycle
     if (latency < clockPeriod())
         latency = clockPeriod();
 
-    if (_status != Idle)
-        reschedule(tickEvent, curTick() + latency, true);
+    return _status != Idle ? latency : 0;
+}
+
+const uint8_t *
+AtomicSimpleCPU::fetchHostPtr(Addr paddr, Addr size)
+{
+    const AddrRange range = RangeSize(paddr, size);
+    auto it = fetchBackdoors.contains(range);
+    if (it == fetchBackdoors.end()) {
+        MemBackdoorPtr bd = nullptr;
+        icachePort.sendMemBackdoorReq(
+                MemBackdoorReq(range, MemBackdoor::Readable), bd);
+        if (!bd || !bd->readable() || !range.isSubset(bd->range()) ||
+                fetchBackdoors.insert(bd->range(), bd) ==
+                fetchBackdoors.end()) {
+            warn_once("%s: No back door to instruction memory at %#x, "
+                      "the block cache will be ineffective.\n",
+                      name(), paddr);
+            return nullptr;
+        }
+
+        // Install a callback to erase this backdoor if it goes away.
+        auto callback = [this](const MemBackdoor &backdoor) {
+                for (auto it = fetchBackdoors.begin();
+                        it != fetchBackdoors.end(); it++) {
+                    if (it->second == &backdoor) {
+                        fetchBackdoors.erase(it);
+                        return;
+                    }
+                }
+                panic("Got invalidation for unknown memory backdoor.");
+            };
+        bd->addInvalidationCallback(callback);
+        it = fetchBackdoors.contains(range);
+    }
+
+    const MemBackdoor *bd = it->second;
+    return bd->ptr() + (paddr - bd->range().start());
 }
 
 Tick
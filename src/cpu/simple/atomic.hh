@@ -41,8 +41,14 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <vector>
+
+#include "base/addr_range_map.hh"
 #include "cpu/simple/base.hh"
+#include "cpu/simple/block_cache.hh"
 #include "cpu/simple/exec_context.hh"
+#include "mem/backdoor.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -67,9 +73,43 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
-    // main simulation loop (one cycle)
+    /**
+     * Maximum number of cycles executed back to back in one call to
+     * tick() when skipping the event queue.
+     */
+    static constexpr unsigned MaxBackToBackCycles = 1024;
+
+    /** Decoded blocks of each thread, empty unless enabled. */
+    std::vector<std::unique_ptr<DecodedBlockCache>> blockCaches;
+
+    /** Back doors to instruction memory used by the block caches. */
+    AddrRangeMap<MemBackdoorPtr, 1> fetchBackdoors;
+
+    /** The PC of the instruction being decoded, for the block cache. */
+    std::unique_ptr<PCStateBase> fetchPC;
+
+    // main simulation loop
     void tick();
 
+    /**
+     * Execute one cycle.
+     *
+     * @return The latency until the next cycle, or 0 if the CPU
+     *         stopped or drained.
+     */
+    Tick tickCycle();
+
+    /** Get a host pointer to instruction memory, if there is one. */
+    const uint8_t *fetchHostPtr(Addr paddr, Addr size);
+
+    /** Let the block caches know about a write to memory. */
+    void
+    invalidateBlocks(Addr paddr, Addr size)
+    {
+        for (auto &cache : blockCaches)
+            cache->invalidate(paddr, size);
+    }
+
     /**
      * Check if a system is in a drained state.
      *
@@ -380,6 +380,38 @@ BaseSimpleCPU::preExecute()
         curStaticInst = curMacroStaticInst->fetchMicroop(pc_state.microPC());
     }
 
+    beginInst();
+}
+
+void
+BaseSimpleCPU::preExecute(const StaticInstPtr &inst)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread* thread = t_info.thread;
+
+    assert(!curMacroStaticInst);
+
+    t_info.setPredicate(true);
+    t_info.setMemAccPredicate(true);
+    t_info.stayAtPC = false;
+
+    if (inst->isMacroop()) {
+        curMacroStaticInst = inst;
+        curStaticInst =
+            curMacroStaticInst->fetchMicroop(thread->pcState().microPC());
+    } else {
+        curStaticInst = inst;
+    }
+
+    beginInst();
+}
+
+void
+BaseSimpleCPU::beginInst()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread* thread = t_info.thread;
+
     //If we decoded an instruction this "tick", record information about it.
     if (curStaticInst) {
 #if TRACING_ON
@@ -132,11 +132,25 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Trace, predict and count the instruction that preExecute() is
+     * about to execute.
+     */
+    void beginInst();
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
     void serviceInstCountEvents();
     void preExecute();
+    /**
+     * Start executing an instruction that was decoded earlier instead
+     * of fetching and decoding one. The PC must already be what
+     * decoding the instruction would have left it at.
+     *
+     * @param inst The decoded instruction, which may be a macroop.
+     */
+    void preExecute(const StaticInstPtr &inst);
     void postExecute();
     void advancePC(const Fault &fault);
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/block_cache.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gem5
+{
+
+DecodedBlockCache::DecodedBlockCache(HostPtrFunc host_ptr)
+    : hostPtr(std::move(host_ptr))
+{
+}
+
+const DecodedBlockCache::Inst *
+DecodedBlockCache::enter(const PCStateBase &pc, uint64_t context,
+                         Addr paddr)
+{
+    active = nullptr;
+
+    auto it = index.find(paddr);
+    if (it == index.end())
+        return nullptr;
+
+    Block *block = it->second.block;
+    const size_t i = it->second.index;
+    const Inst &inst = block->insts[i];
+
+    // The same code may be mapped at another address or decoded in
+    // another context, which doesn't make the block invalid
+    if (!inst.pc->equals(pc) || block->context != context)
+        return nullptr;
+
+    const uint8_t *host = hostPtr(block->paddr, block->bytes.size());
+    if (!host ||
+            memcmp(host, block->bytes.data(), block->bytes.size()) != 0) {
+        erase(block);
+        return nullptr;
+    }
+
+    // Don't let the block being recorded continue after this one
+    endBlock();
+
+    active = block;
+    pos = i + 1;
+    return &inst;
+}
+
+void
+DecodedBlockCache::recordFetch(Addr vaddr, Addr paddr, Addr size,
+                               const uint8_t *data)
+{
+    assert(sameRegion(vaddr, vaddr + size - 1));
+
+    const bool first = !instFetched;
+    instFetched = true;
+
+    if (!recording.bytes.empty()) {
+        const Addr end = recording.vaddr + recording.bytes.size();
+        if (paddr - vaddr == recording.paddr - recording.vaddr &&
+                vaddr >= recording.vaddr && vaddr <= end &&
+                sameRegion(recording.vaddr, vaddr)) {
+            // Bytes fetched more than once must not have changed
+            const Addr overlap = std::min(end, vaddr + size) - vaddr;
+            if (memcmp(&recording.bytes[vaddr - recording.vaddr], data,
+                       overlap) == 0) {
+                recording.bytes.insert(recording.bytes.end(),
+                                       data + overlap, data + size);
+                return;
+            }
+        }
+
+        endBlock();
+        instFetched = true;
+    }
+
+    // If this isn't the first fetch of the instruction, the new block
+    // doesn't hold all of its bytes
+    instBroken = !first;
+    recording.vaddr = vaddr;
+    recording.paddr = paddr;
+    recording.bytes.assign(data, data + size);
+}
+
+void
+DecodedBlockCache::recordInst(const PCStateBase &pc,
+                              const PCStateBase &decoded_pc,
+                              const StaticInstPtr &inst, uint64_t context,
+                              bool last)
+{
+    const bool broken = instBroken;
+    instBroken = false;
+    instFetched = false;
+
+    if (broken || recording.bytes.empty())
+        return;
+
+    if (recording.insts.empty()) {
+        recording.context = context;
+    } else if (recording.context != context) {
+        endBlock();
+        return;
+    }
+
+    recording.insts.push_back(Inst{std::unique_ptr<PCStateBase>(pc.clone()),
+            pc.instAddr() - recording.vaddr + recording.paddr,
+            std::unique_ptr<PCStateBase>(decoded_pc.clone()), inst});
+
+    if (last || recording.insts.size() == MaxBlockInsts)
+        endBlock();
+}
+
+bool
+DecodedBlockCache::endsBlock(const StaticInstPtr &inst)
+{
+    return inst->isControl() || inst->isSerializeBefore() ||
+        inst->isSerializeAfter() || inst->isNonSpeculative() ||
+        inst->isSquashAfter() || inst->isSyscall() || inst->isQuiesce();
+}
+
+void
+DecodedBlockCache::endBlock()
+{
+    if (!recording.insts.empty() &&
+            hostPtr(recording.paddr, recording.bytes.size())) {
+        if (blocks.size() == MaxBlocks) {
+            active = nullptr;
+            index.clear();
+            blocks.clear();
+        }
+
+        blocks.push_front(std::move(recording));
+        Block &block = blocks.front();
+        block.self = blocks.begin();
+        for (size_t i = 0; i < block.insts.size(); ++i)
+            index[block.insts[i].paddr] = Location{&block, i};
+    }
+
+    recording = Block();
+    instBroken = false;
+    instFetched = false;
+}
+
+void
+DecodedBlockCache::invalidate(Addr paddr, Addr size)
+{
+    if (active && active->overlaps(paddr, size))
+        erase(active);
+}
+
+void
+DecodedBlockCache::erase(Block *block)
+{
+    for (const auto &inst : block->insts) {
+        auto it = index.find(inst.paddr);
+        if (it != index.end() && it->second.block == block)
+            index.erase(it);
+    }
+    if (active == block)
+        active = nullptr;
+    blocks.erase(block->self);
+}
+
+void
+DecodedBlockCache::clear()
+{
+    active = nullptr;
+    index.clear();
+    blocks.clear();
+    recording = Block();
+    instBroken = false;
+    instFetched = false;
+}
+
+} // namespace gem5
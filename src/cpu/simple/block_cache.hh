@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_BLOCK_CACHE_HH__
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+/**
+ * A cache of decoded basic blocks, which lets a simple CPU execute
+ * instructions without fetching and decoding them again.
+ *
+ * Blocks are recorded while instructions are fetched and decoded as
+ * usual. For every instruction, a block holds the PC it was fetched
+ * with, the PC after decoding it and the decoded instruction, which
+ * may be a macroop. A block ends at control, serializing and
+ * non-speculative instructions.
+ *
+ * Instructions are looked up by the physical address their fetch
+ * translates to, so the CPU still translates every fetch as usual and
+ * changes to the page tables, the TLBs or the address space are
+ * observed as without the cache. Only the instruction memory access
+ * and the decoding are skipped.
+ *
+ * All instructions of a block are fetched from the same naturally
+ * aligned region of RegionBytes, which is no larger than the smallest
+ * page of any ISA. A block keeps a copy of the bytes its instructions
+ * were decoded from, and is only entered if the bytes in memory still
+ * match the copy. Blocks that fail this check are dropped.
+ *
+ * Once a block has been entered, its instructions are used as long as
+ * the next fetch translates to the address of the next instruction of
+ * the block with the same PC, and the decoder context is unchanged.
+ * The CPU must leave the block whenever anything else might have
+ * modified memory, e.g., when other events ran, and call invalidate()
+ * for its own writes.
+ */
+class DecodedBlockCache
+{
+  public:
+    /** Size and alignment of the region a block is fetched from. */
+    static constexpr Addr RegionBytes = 4096;
+    /** Maximum number of instructions in a block. */
+    static constexpr size_t MaxBlockInsts = 64;
+    /** The cache is flushed when it holds this many blocks. */
+    static constexpr size_t MaxBlocks = 16 * 1024;
+
+    struct Inst
+    {
+        /** The PC the instruction was fetched with. */
+        std::unique_ptr<PCStateBase> pc;
+        /** The physical address of the instruction. */
+        Addr paddr;
+        /** The PC after decoding the instruction. */
+        std::unique_ptr<PCStateBase> decodedPC;
+        StaticInstPtr inst;
+    };
+
+    /**
+     * Returns a host pointer to size bytes of instruction memory at
+     * paddr, or nullptr if there is no direct access to it.
+     */
+    using HostPtrFunc =
+        std::function<const uint8_t *(Addr paddr, Addr size)>;
+
+    DecodedBlockCache(HostPtrFunc host_ptr);
+
+    DecodedBlockCache(const DecodedBlockCache &) = delete;
+    DecodedBlockCache &operator=(const DecodedBlockCache &) = delete;
+
+    /**
+     * Get the decoded instruction for a fetch, which is either the next
+     * instruction of the current block or the start of another block.
+     *
+     * @param pc The PC of the next fetch.
+     * @param context The current decoder context.
+     * @param vaddr The virtual address of the translated fetch.
+     * @param paddr The physical address vaddr translates to.
+     * @return The instruction, or nullptr if there is no valid one.
+     */
+    const Inst *
+    find(const PCStateBase &pc, uint64_t context, Addr vaddr, Addr paddr)
+    {
+        const Addr inst_paddr = pc.instAddr() - vaddr + paddr;
+        if (active && pos < active->insts.size() &&
+                context == active->context) {
+            const Inst &inst = active->insts[pos];
+            if (inst.paddr == inst_paddr && inst.pc->equals(pc)) {
+                ++pos;
+                return &inst;
+            }
+        }
+        return enter(pc, context, inst_paddr);
+    }
+
+    /** Stop using the current block. */
+    void leave() { active = nullptr; }
+
+    /**
+     * Record a fetch of the instruction being decoded.
+     *
+     * @param data The fetched bytes, as passed to the decoder.
+     */
+    void recordFetch(Addr vaddr, Addr paddr, Addr size,
+                     const uint8_t *data);
+
+    /**
+     * Record an instruction decoded from the fetches recorded since
+     * the last instruction.
+     *
+     * @param last The block ends with this instruction, see endsBlock().
+     */
+    void recordInst(const PCStateBase &pc, const PCStateBase &decoded_pc,
+                    const StaticInstPtr &inst, uint64_t context, bool last);
+
+    /**
+     * Check if a block has to end after an instruction, i.e., if it is
+     * a control, serializing or non-speculative instruction.
+     */
+    static bool endsBlock(const StaticInstPtr &inst);
+
+    /** Add the block being recorded to the cache. */
+    void endBlock();
+
+    /** Handle a write to memory, leaving the current block if needed. */
+    void invalidate(Addr paddr, Addr size);
+
+    /** Drop all blocks, including the one being recorded. */
+    void clear();
+
+  protected:
+    struct Block;
+    using BlockList = std::list<Block>;
+
+    struct Block
+    {
+        /** Address of the first byte the block was decoded from. */
+        Addr vaddr = 0;
+        Addr paddr = 0;
+        /** Copy of the bytes the block was decoded from. */
+        std::vector<uint8_t> bytes;
+
+        uint64_t context = 0;
+        std::vector<Inst> insts;
+
+        BlockList::iterator self;
+
+        bool
+        overlaps(Addr addr, Addr size) const
+        {
+            return addr < paddr + bytes.size() && paddr < addr + size;
+        }
+    };
+
+    struct Location
+    {
+        Block *block;
+        size_t index;
+    };
+
+    static bool
+    sameRegion(Addr a, Addr b)
+    {
+        return (a ^ b) < RegionBytes;
+    }
+
+    /**
+     * Enter the block that holds the instruction at paddr, after
+     * checking that it is still valid.
+     */
+    const Inst *enter(const PCStateBase &pc, uint64_t context, Addr paddr);
+
+    void erase(Block *block);
+
+    HostPtrFunc hostPtr;
+
+    BlockList blocks;
+    /**
+     * The location of the newest cached instruction at a physical
+     * address.
+     */
+    std::unordered_map<Addr, Location> index;
+
+    Block *active = nullptr;
+    /** Index of the next instruction in the active block. */
+    size_t pos = 0;
+
+    Block recording;
+    /** Some bytes of the current instruction have been fetched. */
+    bool instFetched = false;
+    /** The fetches of the current instruction are not all recorded. */
+    bool instBroken = false;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_BLOCK_CACHE_HH__
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpu/simple/block_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+using TestPCState = GenericISA::SimplePCState<4>;
+
+/** Instruction memory at physical address 0 and a cache that uses it. */
+class BlockCacheTest : public testing::Test
+{
+  protected:
+    std::vector<uint8_t> mem = std::vector<uint8_t>(0x4000, 0x5a);
+    DecodedBlockCache cache{[this](Addr paddr, Addr size) {
+        return paddr + size <= mem.size() ? &mem[paddr] : nullptr;
+    }};
+
+    /**
+     * Record a block of num instructions at vaddr, as if vaddr
+     * translated to paddr. The decoded instructions themselves don't
+     * matter to the cache.
+     */
+    void
+    record(Addr vaddr, Addr paddr, int num, uint64_t context=0)
+    {
+        for (int i = 0; i < num; i++) {
+            cache.recordFetch(vaddr + 4 * i, paddr + 4 * i, 4,
+                              &mem[paddr + 4 * i]);
+            TestPCState pc(vaddr + 4 * i);
+            TestPCState decoded_pc = pc;
+            cache.recordInst(pc, decoded_pc, nullptr, context,
+                             i == num - 1);
+        }
+    }
+
+    const DecodedBlockCache::Inst *
+    find(Addr vaddr, Addr paddr, uint64_t context=0)
+    {
+        return cache.find(TestPCState(vaddr), context, vaddr, paddr);
+    }
+};
+
+} // anonymous namespace
+
+/** Recorded instructions are found at their physical address. */
+TEST_F(BlockCacheTest, Hit)
+{
+    record(0x10000, 0x1000, 4);
+    for (int i = 0; i < 4; i++) {
+        const DecodedBlockCache::Inst *inst =
+            find(0x10000 + 4 * i, 0x1000 + 4 * i);
+        ASSERT_NE(inst, nullptr);
+        EXPECT_EQ(inst->paddr, 0x1000 + 4 * i);
+        EXPECT_EQ(inst->pc->instAddr(), 0x10000 + 4 * i);
+    }
+
+    // Blocks can be entered in the middle
+    cache.leave();
+    ASSERT_NE(find(0x10008, 0x1008), nullptr);
+    ASSERT_NE(find(0x1000c, 0x100c), nullptr);
+}
+
+/** Fetches that translate differently don't use the block. */
+TEST_F(BlockCacheTest, TranslationMiss)
+{
+    record(0x10000, 0x1000, 4);
+
+    // The page was remapped, e.g., to another address space
+    EXPECT_EQ(find(0x10000, 0x2000), nullptr);
+    // The same code is mapped at another address
+    EXPECT_EQ(find(0x20000, 0x1000), nullptr);
+    // The remapping only affects the rest of the block
+    ASSERT_NE(find(0x10000, 0x1000), nullptr);
+    EXPECT_EQ(find(0x10004, 0x2004), nullptr);
+
+    // Neither of these invalidates the block
+    ASSERT_NE(find(0x10000, 0x1000), nullptr);
+    ASSERT_NE(find(0x10004, 0x1004), nullptr);
+}
+
+/** Instructions are only used in the context they were decoded in. */
+TEST_F(BlockCacheTest, ContextMiss)
+{
+    record(0x10000, 0x1000, 4, 1);
+    EXPECT_EQ(find(0x10000, 0x1000, 2), nullptr);
+    ASSERT_NE(find(0x10000, 0x1000, 1), nullptr);
+    EXPECT_EQ(find(0x10004, 0x1004, 2), nullptr);
+}
+
+/** Blocks whose code was modified are dropped when entered. */
+TEST_F(BlockCacheTest, ModifiedCode)
+{
+    record(0x10000, 0x1000, 4);
+    mem[0x1009] = 0;
+    EXPECT_EQ(find(0x10000, 0x1000), nullptr);
+
+    // Restoring the code doesn't bring the block back
+    mem[0x1009] = 0x5a;
+    EXPECT_EQ(find(0x10000, 0x1000), nullptr);
+    EXPECT_EQ(find(0x10008, 0x1008), nullptr);
+}
+
+/** Writes of the CPU to the current block invalidate it. */
+TEST_F(BlockCacheTest, Invalidate)
+{
+    record(0x10000, 0x1000, 4);
+    record(0x10100, 0x1100, 4);
+
+    ASSERT_NE(find(0x10000, 0x1000), nullptr);
+    // Writes to other blocks are checked when these are entered
+    cache.invalidate(0x1104, 4);
+    cache.invalidate(0x1010, 4);
+    ASSERT_NE(find(0x10004, 0x1004), nullptr);
+
+    cache.invalidate(0x100c, 1);
+    EXPECT_EQ(find(0x10008, 0x1008), nullptr);
+    EXPECT_EQ(find(0x10000, 0x1000), nullptr);
+    ASSERT_NE(find(0x10100, 0x1100), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(find(0x10100, 0x1100), nullptr);
+}
+
+/** Blocks end where the CPU says so, and can be entered at any point. */
+TEST_F(BlockCacheTest, BlockEnd)
+{
+    record(0x10000, 0x1000, 2);
+    record(0x10008, 0x1008, 2);
+    ASSERT_NE(find(0x10000, 0x1000), nullptr);
+    ASSERT_NE(find(0x10004, 0x1004), nullptr);
+    // Found in the next block
+    ASSERT_NE(find(0x10008, 0x1008), nullptr);
+
+    // An instruction that isn't fetched at all isn't recorded
+    TestPCState pc(0x10ffc);
+    cache.recordInst(pc, pc, nullptr, 0, false);
+    EXPECT_EQ(find(0x10ffc, 0x1ffc), nullptr);
+}
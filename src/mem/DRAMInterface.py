@@ -70,6 +70,12 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Idle ranks do not need to simulate every refresh, the refreshes are
+    # accounted for when the ranks are next used, with the same stats
+    skip_idle_refresh = Param.Bool(
+        True, "Skip the refresh events while all ranks are idle"
+    )
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
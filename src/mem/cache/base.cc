@@ -246,7 +246,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -638,6 +638,10 @@ BaseCache::recvAtomic(PacketPtr pkt)
     // writebacks... that would mean that someone used an atomic
     // access in timing mode
 
+    if (system->warmingCaches()) {
+        return warmAtomic(pkt);
+    }
+
     // We use lookupLatency here because it is used to specify the latency
     // to access.
     Cycles lat = lookupLatency;
@@ -711,6 +715,121 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+Tick
+BaseCache::warmAtomic(PacketPtr pkt)
+{
+    const bool is_secure = pkt->isSecure();
+    Cycles lat = lookupLatency;
+    PacketList writebacks;
+
+    if (pkt->isEviction()) {
+        // Evictions are handled as in the other modes, a writeback
+        // always allocates, and a clean eviction stops at the first
+        // copy of the line
+        CacheBlk *blk = tags->findBlock(pkt->getAddr(), is_secure);
+        if (pkt->isWriteback()) {
+            if (!blk) {
+                blk = allocateBlock(pkt, writebacks);
+                doWritebacksAtomic(writebacks);
+            }
+            if (blk) {
+                blk->setCoherenceBits(CacheBlk::ReadableBit);
+                if (pkt->cmd == MemCmd::WritebackDirty) {
+                    blk->setCoherenceBits(CacheBlk::DirtyBit);
+                }
+                if (!pkt->hasSharers()) {
+                    blk->setCoherenceBits(CacheBlk::WritableBit);
+                }
+                pkt->writeDataToBlock(blk->data, blkSize);
+            }
+        }
+        if (!blk) {
+            memSidePort.sendAtomic(pkt);
+        }
+        return lat * clockPeriod();
+    }
+
+    if (pkt->req->isUncacheable() || pkt->isLLSC() || pkt->isAtomicOp() ||
+        pkt->cmd == MemCmd::SwapReq || pkt->isClean() ||
+        !(pkt->isRead() || pkt->isWrite())) {
+        CacheBlk *blk = tags->findBlock(pkt->getAddr(), is_secure);
+        if (blk && (pkt->req->isUncacheable() || pkt->needsWritable() ||
+                    pkt->isInvalidate())) {
+            evictBlock(blk, writebacks);
+            doWritebacksAtomic(writebacks);
+        }
+        return lat * clockPeriod() + memSidePort.sendAtomic(pkt);
+    }
+
+    const bool needs_writable = pkt->needsWritable();
+    Cycles tag_latency(0);
+    CacheBlk *blk = tags->accessBlock(pkt, tag_latency);
+    if (blk && (!needs_writable || blk->isSet(CacheBlk::WritableBit))) {
+        incHitCount(pkt);
+    } else {
+        incMissCount(pkt);
+
+        // The whole line is fetched straight into the block
+        const MemCmd cmd = needs_writable ? MemCmd::ReadExReq :
+            (isReadOnly || clusivity == enums::mostly_excl ?
+             MemCmd::ReadCleanReq : MemCmd::ReadSharedReq);
+        Packet bus_pkt(pkt->req, cmd, blkSize);
+        if (pkt->hasSharers() && !needs_writable) {
+            bus_pkt.setHasSharers();
+        }
+
+        if (!blk && allocOnFill(pkt->cmd)) {
+            blk = allocateBlock(&bus_pkt, writebacks);
+            doWritebacksAtomic(writebacks);
+        }
+        if (!blk) {
+            return lat * clockPeriod() + memSidePort.sendAtomic(pkt);
+        }
+
+        bus_pkt.dataStatic(blk->data);
+        lat += ticksToCycles(memSidePort.sendAtomic(&bus_pkt));
+
+        if (bus_pkt.isError()) {
+            invalidateBlock(blk);
+            pkt->makeAtomicResponse();
+            pkt->copyError(&bus_pkt);
+            return lat * clockPeriod();
+        }
+
+        // Set the state as handleFill() does, a line passed on by an
+        // owner above or below is kept dirty
+        blk->setCoherenceBits(CacheBlk::ReadableBit);
+        if (!bus_pkt.hasSharers()) {
+            blk->setCoherenceBits(CacheBlk::WritableBit);
+            if (bus_pkt.cacheResponding()) {
+                blk->setCoherenceBits(CacheBlk::DirtyBit);
+            }
+        }
+    }
+
+    // Writes dirty the line, and dirty lines are passed up to caches
+    // above, so that evictions allocate in the levels below as they
+    // would in timing mode
+    satisfyRequest(pkt, blk);
+
+    if (pkt->isWrite()) {
+        // Keep memory, and any other copy of the line, up to date
+        Packet wt_pkt(pkt, true, false);
+        wt_pkt.cmd = MemCmd::WriteReq;
+        wt_pkt.senderState = nullptr;
+        wt_pkt.dataStaticConst(pkt->getConstPtr<uint8_t>());
+        memSidePort.sendFunctional(&wt_pkt);
+    }
+
+    maintainClusivity(pkt->fromCache(), blk);
+
+    if (pkt->needsResponse()) {
+        pkt->makeAtomicResponse();
+    }
+
+    return lat * clockPeriod();
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -1699,7 +1818,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1742,7 +1861,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1816,7 +1935,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
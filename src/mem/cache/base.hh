@@ -591,6 +591,28 @@ class BaseCache : public ClockedObject
      */
     virtual Tick recvAtomic(PacketPtr pkt);
 
+    /**
+     * Performs an atomic access when the system is warming caches.
+     *
+     * Only the tags, the coherence state and the replacement state
+     * are maintained, and missing lines are fetched straight into the
+     * block. Blocks are marked dirty and evictions allocate in the
+     * levels below as in timing mode, so that the contents of the
+     * caches match those of a timing warm-up with no outstanding
+     * misses. Writes are also written through to memory using
+     * functional accesses. Accesses that need more than that
+     * (uncacheable accesses, atomic operations, swaps, LL/SC, cache
+     * maintenance) drop the local copy of the line and are forwarded
+     * below.
+     *
+     * As in atomic mode, the prefetcher is not notified of any access,
+     * so it is neither trained nor issues prefetches while warming.
+     *
+     * @param pkt The request to perform.
+     * @return The number of ticks required for the access.
+     */
+    Tick warmAtomic(PacketPtr pkt);
+
     /**
      * Snoop for the provided request in the cache and return the estimated
      * time taken.
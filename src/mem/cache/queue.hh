@@ -48,7 +48,9 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +103,63 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Allocated entries indexed by block address. Each bucket is a
+     * chain of entries, linked through matchNext, in the order they
+     * were allocated, so that lookups return the same entry as a walk
+     * of the allocatedList would.
+     */
+    std::vector<Entry*> matchBuckets;
+    /** Next entry in the chain of each entry, indexed like entries. */
+    std::vector<Entry*> matchNext;
+    /** Number of bits of the bucket index. */
+    const int matchBits;
+
+    /** Fibonacci hashing of the block address. */
+    size_t
+    matchBucket(Addr blk_addr) const
+    {
+        return (blk_addr * 0x9E3779B97F4A7C15ULL) >> (64 - matchBits);
+    }
+
+    Entry*&
+    nextMatch(const Entry *entry)
+    {
+        return matchNext[entry - entries.data()];
+    }
+
+    Entry*
+    nextMatch(const Entry *entry) const
+    {
+        return matchNext[entry - entries.data()];
+    }
+
+    /**
+     * Add a newly allocated entry to the address index. Must be called
+     * once the block address of the entry is set.
+     */
+    void
+    addToMatchIndex(Entry *entry)
+    {
+        Entry **link = &matchBuckets[matchBucket(entry->blkAddr)];
+        while (*link)
+            link = &nextMatch(*link);
+        *link = entry;
+        nextMatch(entry) = nullptr;
+    }
+
+    void
+    removeFromMatchIndex(Entry *entry)
+    {
+        Entry **link = &matchBuckets[matchBucket(entry->blkAddr)];
+        while (*link != entry) {
+            assert(*link);
+            link = &nextMatch(*link);
+        }
+        *link = nextMatch(entry);
+        nextMatch(entry) = nullptr;
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -135,6 +194,9 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        matchBuckets(size_t(1) << ceilLog2(2 * numEntries), nullptr),
+        matchNext(numEntries, nullptr),
+        matchBits(ceilLog2(2 * numEntries)),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -168,7 +230,8 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        for (Entry *entry = matchBuckets[matchBucket(blk_addr)]; entry;
+             entry = nextMatch(entry)) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -206,12 +269,26 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
-        for (const auto& ready_entry : readyList) {
-            if (ready_entry->conflictAddr(entry)) {
-                return ready_entry;
+        // The entries that are not in service are the ones on the
+        // readyList
+        Entry *match = nullptr;
+        for (Entry *other = matchBuckets[matchBucket(entry->blkAddr)];
+             other; other = nextMatch(other)) {
+            if (other->inService || !other->conflictAddr(entry))
+                continue;
+            if (!match) {
+                match = other;
+                continue;
+            }
+            // Several ready entries for the same block, return the one
+            // that is first in the readyList
+            for (const auto& ready_entry : readyList) {
+                if (ready_entry->conflictAddr(entry)) {
+                    return ready_entry;
+                }
             }
         }
-        return nullptr;
+        return match;
     }
 
     /**
@@ -241,6 +318,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromMatchIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
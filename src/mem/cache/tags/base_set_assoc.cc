@@ -45,6 +45,7 @@
 
 #include "mem/cache/tags/base_set_assoc.hh"
 
+#include <cassert>
 #include <string>
 
 #include "base/intmath.hh"
@@ -55,7 +56,8 @@ namespace gem5
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
      sequentialAccess(p.sequential_access),
-     replacementPolicy(p.replacement_policy)
+     replacementPolicy(p.replacement_policy), setAssocIndexing(nullptr),
+     numWays(0)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
@@ -83,12 +85,52 @@ BaseSetAssoc::tagsInit()
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    // Set associative indexing places the ways of a set next to each
+    // other, so the tags can be looked up without the indexing policy
+    auto *set_assoc = dynamic_cast<SetAssociative*>(indexingPolicy);
+    if (set_assoc &&
+        set_assoc->getNumSets() * set_assoc->getAssoc() == numBlocks) {
+        setAssocIndexing = set_assoc;
+        numWays = set_assoc->getAssoc();
+        tagKeys.assign(numBlocks, 0);
+        candidates.resize(numWays);
+    }
+}
+
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!setAssocIndexing) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    const size_t first = size_t(setAssocIndexing->getSetIndex(addr)) * numWays;
+    const uint64_t *keys = &tagKeys[first];
+    const uint64_t key = tagKey(extractTag(addr), is_secure);
+
+    // A block is present in at most one way, so adding up the (one-based)
+    // ways that match gives the way of the block, or zero on a miss. This
+    // has no early exit, which lets the loop be vectorized.
+    unsigned match = 0;
+    for (unsigned way = 0; way < numWays; ++way) {
+        match += keys[way] == key ? way + 1 : 0;
+    }
+
+    if (match == 0) {
+        return nullptr;
+    }
+
+    CacheBlk *blk = const_cast<CacheBlk*>(&blks[first + match - 1]);
+    assert(blk->matchTag(extractTag(addr), is_secure));
+    return blk;
 }
 
 void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
     BaseTags::invalidate(blk);
+    updateTagKey(blk);
 
     // Decrease the number of tags in use
     stats.tagsInUse--;
@@ -101,6 +143,8 @@ void
 BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
 {
     BaseTags::moveBlock(src_blk, dest_blk);
+    updateTagKey(src_blk);
+    updateTagKey(dest_blk);
 
     // Since the blocks were using different replacement data pointers,
     // we must touch the replacement data of the new entry, and invalidate
@@ -59,6 +59,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -87,6 +88,48 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /**
+     * The indexing policy if it is set associative, nullptr otherwise. The
+     * possible entries of an address are then the ways of a single set,
+     * which are consecutive in blks, so neither lookups nor victim
+     * selection need to go through getPossibleEntries().
+     */
+    SetAssociative *setAssocIndexing;
+
+    /** The number of ways of a set when setAssocIndexing is used. */
+    unsigned numWays;
+
+    /**
+     * The tag, secure bit and valid bit of every block, as made by
+     * tagKey(), in the same order as blks. Invalid blocks have a zero key,
+     * so they never match. Keeping the keys of a set contiguous lets the
+     * compiler vectorize the comparisons of a lookup.
+     */
+    std::vector<uint64_t> tagKeys;
+
+    /** The replacement candidates of the set being victimized. */
+    std::vector<ReplaceableEntry*> candidates;
+
+    static uint64_t
+    tagKey(Addr tag, bool is_secure)
+    {
+        return (tag << 2) | (is_secure ? 2 : 0) | 1;
+    }
+
+    /**
+     * Update the key of a block after its tag or valid bit changed.
+     *
+     * @param blk The block to update.
+     */
+    void
+    updateTagKey(const CacheBlk *blk)
+    {
+        if (setAssocIndexing) {
+            tagKeys[blk - blks.data()] = blk->isValid() ?
+                tagKey(blk->getTag(), blk->isSecure()) : 0;
+        }
+    }
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -114,6 +157,16 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find a block given its address and security bit. This compares the
+     * packed keys of the set of the address when possible.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -169,13 +222,25 @@ class BaseSetAssoc : public BaseTags
                          const std::size_t size,
                          std::vector<CacheBlk*>& evict_blks) override
     {
-        // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(addr);
+        CacheBlk* victim;
+        if (setAssocIndexing) {
+            // The candidates are all the ways of the set of the address
+            const size_t first =
+                size_t(setAssocIndexing->getSetIndex(addr)) * numWays;
+            for (unsigned way = 0; way < numWays; ++way) {
+                candidates[way] = &blks[first + way];
+            }
+            victim = static_cast<CacheBlk*>(
+                replacementPolicy->getVictim(candidates));
+        } else {
+            // Get possible entries to be victimized
+            const std::vector<ReplaceableEntry*> entries =
+                indexingPolicy->getPossibleEntries(addr);
 
-        // Choose replacement victim from replacement candidates
-        CacheBlk* victim = static_cast<CacheBlk*>(replacementPolicy->getVictim(
-                                entries));
+            // Choose replacement victim from replacement candidates
+            victim = static_cast<CacheBlk*>(
+                replacementPolicy->getVictim(entries));
+        }
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
@@ -193,6 +258,7 @@ class BaseSetAssoc : public BaseTags
     {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        updateTagKey(blk);
 
         // Increment tag counter
         stats.tagsInUse++;
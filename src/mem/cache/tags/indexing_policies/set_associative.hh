@@ -118,6 +118,16 @@ class SetAssociative : public BaseIndexingPolicy
     std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
                                                                      override;
 
+    /**
+     * Get the set an address maps to. The possible entries of the address
+     * are the entries of all ways of that set. Unlike getPossibleEntries()
+     * this does not copy them.
+     *
+     * @param addr The address to calculate the set for.
+     * @return The set index of the address.
+     */
+    uint32_t getSetIndex(const Addr addr) const { return extractSet(addr); }
+
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
      *
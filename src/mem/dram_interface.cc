@@ -59,116 +59,122 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
+    // The queue indexes its packets per bank, and since the packets of a
+    // bank are in arrival order, only the oldest candidates of every bank
+    // need to be compared. In order of preference, we pick:
+    // 1) the oldest row hit that can issue seamlessly, i.e., without
+    //    additional rank-to-rank or same bank-group delays,
+    // 2) the oldest row miss to one of the banks that can be prepared
+    //    first, if the PRE/ACT sequence can be done without impacting
+    //    utilization, which selects closed rows to enable more open row
+    //    possibilities in future selections,
+    // 3) the oldest row hit that is not seamless, but bank prepped and
+    //    ready,
+    // 4) the oldest row miss to one of the banks that can be prepared
+    //    first.
+    const MemPacketQueue::Entry *seamless_hit = nullptr;
+    Tick seamless_col_at = MaxTick;
+    const MemPacketQueue::Entry *prepped_hit = nullptr;
+    Tick prepped_col_at = MaxTick;
+    bool got_miss = false;
+
+    const auto &banks = queue.activeBanks(pseudoChannel);
+    for (const auto *queued : banks) {
+        if (!queued->numDram) {
+            continue;
+        }
 
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip the packets of the bank
+        if (!ranks[queued->rank]->inRefIdleState()) {
+            DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
+                    queued->bank, queued->rank);
+            continue;
+        }
 
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
+        const Bank& bank = ranks[queued->rank]->banks[queued->bank];
+        for (const auto &entry : queued->entries) {
+            const MemPacket* pkt = *entry.pos;
+            if (!pkt->isDram()) {
+                continue;
+            }
 
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
+            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
+                    __func__, pkt->bank, pkt->row);
 
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
+            if (bank.openRow != pkt->row) {
+                got_miss = true;
+                continue;
+            }
 
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
             const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
                                                         bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at) {
+                if (!seamless_hit || entry.seq < seamless_hit->seq) {
+                    seamless_hit = &entry;
+                    seamless_col_at = col_allowed_at;
+                }
+                // no older seamless hit in this bank
+                break;
+            } else if (!prepped_hit || entry.seq < prepped_hit->seq) {
+                prepped_hit = &entry;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
 
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
+    if (seamless_hit) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+        return std::make_pair(seamless_hit->pos, seamless_col_at);
+    }
 
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+    const MemPacketQueue::Entry *earliest_miss = nullptr;
+    Tick earliest_col_at = MaxTick;
+    bool hidden_bank_prep = false;
+    if (got_miss) {
+        // determine entries with earliest bank delay, minBankPrep will
+        // give priority to packets that can issue seamlessly
+        std::vector<uint32_t> earliest_banks;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        for (const auto *queued : banks) {
+            if (!queued->numDram ||
+                !ranks[queued->rank]->inRefIdleState() ||
+                !bits(earliest_banks[queued->rank], queued->bank,
+                      queued->bank)) {
+                continue;
+            }
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
+            const Bank& bank = ranks[queued->rank]->banks[queued->bank];
+            for (const auto &entry : queued->entries) {
+                const MemPacket* pkt = *entry.pos;
+                if (!pkt->isDram() || bank.openRow == pkt->row) {
+                    continue;
                 }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
+                if (!earliest_miss || entry.seq < earliest_miss->seq) {
+                    earliest_miss = &entry;
+                    earliest_col_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                      bank.wrAllowedAt;
+                }
+                // the oldest miss of the bank is the only candidate
+                break;
             }
         }
     }
 
-    if (selected_pkt_it == queue.end()) {
-        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    // give priority to packets that can issue bank commands 'behind the
+    // scenes', any additional delay if any will be due to col-to-col
+    // command requirements
+    if (earliest_miss && (hidden_bank_prep || !prepped_hit)) {
+        return std::make_pair(earliest_miss->pos, earliest_col_at);
+    } else if (prepped_hit) {
+        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
+        return std::make_pair(prepped_hit->pos, prepped_col_at);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    return std::make_pair(queue.end(), MaxTick);
 }
 
 void
@@ -508,32 +514,27 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_bank_conflict = false;
 
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
+            // only the packets to the same bank of this interface matter,
+            // and we must not consider the packet that we are currently
+            // dealing with
+            const MemPacketQueue::Bank *queued = queue[i].findBank(
+                pseudoChannel, mem_pkt->rank, mem_pkt->bank);
+            if (!queued)
+                continue;
+
             // 1) if a hit is found, then both open and close adaptive
             //    policies keep the page open
             // 2) if no hit is found, got_bank_conflict is set to true if a
             //    bank conflict request is waiting in the queue
-            // 3) make sure we are not considering the packet that we are
-            //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-
-                if ((*p)->pseudoChannel != pseudoChannel) {
-                    // only consider if this pkt belongs to this interface
-                    ++p;
-                    continue;
-                }
-
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
+            for (const auto &entry : queued->entries) {
+                const MemPacket *p = *entry.pos;
+                if (p != mem_pkt) {
+                    bool same_row = mem_pkt->row == p->row;
+                    got_more_hits |= same_row;
+                    got_bank_conflict |= !same_row;
                 }
-                ++p;
+                if (got_more_hits)
+                    break;
             }
 
             if (got_more_hits)
@@ -657,7 +658,8 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
-      lastStatsResetTick(0),
+      enableIdleRefreshSkip(_p.skip_idle_refresh),
+      skippingRefresh(false), lastStatsResetTick(0),
       stats(*this)
 {
     DPRINTF(DRAM, "Setting up DRAM Interface\n");
@@ -787,6 +789,7 @@ DRAMInterface::startup()
         // timestamp offset should be in clock cycles for DRAMPower
         timeStampOffset = divCeil(curTick(), tCK);
 
+        skippingRefresh = false;
         for (auto r : ranks) {
             r->startup(curTick() + tREFI - tRP);
         }
@@ -919,6 +922,9 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // the rank is about to be accessed, bring the refresh up to date
+    catchUpRefresh(true);
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -1019,11 +1025,80 @@ DRAMInterface::allRanksDrained() const
 void
 DRAMInterface::suspend()
 {
+    // the refresh events that are still skipped need not be descheduled
+    catchUpRefresh(false);
+    skippingRefresh = false;
+
     for (auto r : ranks) {
         r->suspend();
     }
 }
 
+void
+DRAMInterface::skipIdleRefresh()
+{
+    // with power-down enabled, idle ranks enter self-refresh and do not
+    // schedule any refresh events to begin with
+    if (!enableIdleRefreshSkip || skippingRefresh || enableDRAMPowerdown ||
+        !ctrl->isIdle(this))
+        return;
+
+    for (auto r : ranks) {
+        if (!r->onlyRefreshPending())
+            return;
+    }
+
+    DPRINTF(DRAMState, "All ranks idle, skipping refresh events\n");
+    for (auto r : ranks) {
+        r->nextRefreshAt = r->refreshEvent.when();
+        r->deschedule(r->refreshEvent);
+    }
+    skippingRefresh = true;
+}
+
+void
+DRAMInterface::catchUpRefresh(bool resume)
+{
+    if (!skippingRefresh)
+        return;
+
+    // replay the skipped refreshes in the order they would have been
+    // performed, counting the scheduler restarts that followed them
+    uint64_t restarts = 0;
+    while (true) {
+        Tick ref_tick = MaxTick;
+        for (auto r : ranks) {
+            ref_tick = std::min(ref_tick, r->nextRefreshAt);
+        }
+        // a refresh due at the current tick was scheduled before the
+        // event that brings us here, and would have started first
+        if (ref_tick > curTick())
+            break;
+
+        for (auto r : ranks) {
+            if (r->nextRefreshAt == ref_tick)
+                r->replayRefresh(ref_tick);
+        }
+
+        // a refresh that is still running takes the events back
+        if (ref_tick + tRFC < curTick()) {
+            ++restarts;
+        } else {
+            resume = true;
+        }
+    }
+    ctrl->recordIdleRestarts(restarts);
+
+    if (resume) {
+        DPRINTF(DRAMState, "Resuming refresh events\n");
+        for (auto r : ranks) {
+            if (!r->refreshEvent.scheduled())
+                r->schedule(r->refreshEvent, r->nextRefreshAt);
+        }
+        skippingRefresh = false;
+    }
+}
+
 std::pair<std::vector<uint32_t>, bool>
 DRAMInterface::minBankPrep(const MemPacketQueue& queue,
                       Tick min_col_at) const
@@ -1041,11 +1116,9 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+    for (const auto *queued : queue.activeBanks(pseudoChannel)) {
+        if (queued->numDram && ranks[queued->rank]->inRefIdleState())
+            got_waiting[queued->rank * banksPerRank + queued->bank] = true;
     }
 
     // Find command with optimal bank timing
@@ -1124,6 +1197,7 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
       numBanksActive(0), actTicks(_p.activation_limit, 0), lastBurstTick(0),
+      nextRefreshAt(MaxTick),
       writeDoneEvent([this]{ processWriteDoneEvent(); }, name()),
       activateEvent([this]{ processActivateEvent(); }, name()),
       prechargeEvent([this]{ processPrechargeEvent(); }, name()),
@@ -1168,10 +1242,11 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
-    deschedule(refreshEvent);
+    if (refreshEvent.scheduled())
+        deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
@@ -1204,7 +1279,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick tick)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1214,23 +1289,75 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= tick) {
+             // Move all commands at or before tick to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before tick
+             // next_iter references the 1st command after tick
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after tick
+    // if there are no commands after tick, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
 
+bool
+DRAMInterface::Rank::onlyRefreshPending() const
+{
+    return readEntries == 0 && writeEntries == 0 && numBanksActive == 0 &&
+        outstandingEvents == 0 && !inLowPowerState &&
+        pwrState == PWR_IDLE && pwrStateTrans == PWR_IDLE &&
+        pwrStatePostRefresh == PWR_IDLE && refreshState == REF_IDLE &&
+        refreshEvent.scheduled() && !powerEvent.scheduled() &&
+        !activateEvent.scheduled() && !prechargeEvent.scheduled() &&
+        !writeDoneEvent.scheduled() && !wakeUpEvent.scheduled();
+}
+
+void
+DRAMInterface::Rank::replayRefresh(Tick ref_tick)
+{
+    // the refresh event finds all banks closed and the power event
+    // moves straight from IDLE to REF, see processRefreshEvent
+    stats.pwrStateTime[PWR_IDLE] += ref_tick - pwrStateTick;
+    pwrState = PWR_REF;
+    pwrStateTrans = PWR_REF;
+    pwrStateTick = ref_tick;
+
+    Tick ref_done_at = ref_tick + dram.tRFC;
+
+    for (auto &b : banks) {
+        b.actAllowedAt = ref_done_at;
+    }
+
+    cmdList.push_back(Command(MemCommand::REF, 0, ref_tick));
+    updatePowerStats(ref_tick);
+
+    DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_tick, dram.tCK) -
+            dram.timeStampOffset, rank);
+
+    refreshDueAt = ref_tick + dram.tREFI;
+
+    if (ref_done_at >= curTick()) {
+        // still refreshing, let the refresh event complete it
+        ++outstandingEvents;
+        refreshState = REF_RUN;
+        schedule(refreshEvent, ref_done_at);
+        nextRefreshAt = MaxTick;
+    } else {
+        // the refresh completed and the rank went back to idle
+        stats.pwrStateTime[PWR_REF] += dram.tRFC;
+        pwrState = PWR_IDLE;
+        pwrStateTrans = PWR_IDLE;
+        pwrStateTick = ref_done_at;
+        nextRefreshAt = refreshDueAt - dram.tRP;
+    }
+}
+
 void
 DRAMInterface::Rank::processActivateEvent()
 {
@@ -1414,7 +1541,7 @@ DRAMInterface::Rank::processRefreshEvent()
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
 
         // Update the stats
-        updatePowerStats();
+        updatePowerStats(curTick());
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1673,6 +1800,11 @@ DRAMInterface::Rank::processPowerEvent()
                            " rank %d, PC %d \n", rank, dram.pseudoChannel);
             dram.ctrl->restartScheduler(curTick(), dram.pseudoChannel);
         }
+
+        // if all ranks are idle now, there is no need to simulate the
+        // refreshes until the next access
+        if (pwrState == PWR_IDLE)
+            dram.skipIdleRefresh();
     }
 
     if ((pwrState == PWR_ACT) && (refreshState == REF_PD_EXIT)) {
@@ -1764,17 +1896,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick tick)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(tick);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
     // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    power.powerlib.calcWindowEnergy(divCeil(tick, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1802,7 +1934,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (tick - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -1811,8 +1943,11 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // account for any refreshes skipped while idle
+    dram.catchUpRefresh(false);
+
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
@@ -258,8 +258,10 @@ class DRAMInterface : public MemInterface
 
         /**
          * Function to update Power Stats
+         *
+         * @param tick Tick up to which the stats are updated
          */
-        void updatePowerStats();
+        void updatePowerStats(Tick tick);
 
         /**
          * Schedule a power state transition in the future, and
@@ -347,6 +349,12 @@ class DRAMInterface : public MemInterface
          */
         Tick lastBurstTick;
 
+        /**
+         * When the interface skips the refreshes of its idle ranks, the
+         * tick at which the refresh event would have been scheduled
+         */
+        Tick nextRefreshAt;
+
         Rank(const DRAMInterfaceParams &_p, int _rank,
              DRAMInterface& _dram);
 
@@ -421,11 +429,31 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
+         * or before the given tick to DRAMPower library
          * All commands before curTick are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param tick Tick up to which commands are flushed
+         */
+        void flushCmdList(Tick tick);
+
+        /**
+         * Check if the rank has nothing to do but wait for its next
+         * refresh, with all banks closed and no events outstanding.
+         *
+         * @return true if the refresh event is the only pending event
+         */
+        bool onlyRefreshPending() const;
+
+        /**
+         * Account for a refresh that was skipped while the rank was
+         * idle, exactly as the refresh and power events would have
+         * done. A refresh that has not completed by the current tick
+         * is handed back to the refresh event.
+         *
+         * @param ref_tick Tick at which the refresh started
          */
-        void flushCmdList();
+        void replayRefresh(Tick ref_tick);
 
         /**
          * Computes stats just prior to dump event
@@ -544,6 +572,15 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Skip the refresh events while all ranks are idle */
+    const bool enableIdleRefreshSkip;
+
+    /**
+     * All ranks are idle and their refresh events are not scheduled,
+     * see skipIdleRefresh()
+     */
+    bool skippingRefresh;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -702,6 +739,24 @@ class DRAMInterface : public MemInterface
      */
     void suspend() override;
 
+    /**
+     * Stop scheduling refresh events if all ranks are idle and
+     * nothing but the controller's scheduler depends on them, unless
+     * disabled with the skip_idle_refresh parameter. Called
+     * when a rank completes a refresh. The skipped refreshes are
+     * accounted for by catchUpRefresh().
+     */
+    void skipIdleRefresh();
+
+    /**
+     * Account for all refreshes skipped up to the current tick. A
+     * refresh due at the current tick is replayed too, as its event
+     * would have been scheduled before the one calling this.
+     *
+     * @param resume Schedule the refresh events again
+     */
+    void catchUpRefresh(bool resume) override;
+
     /*
      * @return time to offset next command
      */
@@ -483,6 +483,14 @@ HBMCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+void
+HBMCtrl::resetStats()
+{
+    pc1Int->catchUpRefresh(false);
+
+    MemCtrl::resetStats();
+}
+
 AddrRangeList
 HBMCtrl::getAddrRanges()
 {
@@ -252,6 +252,7 @@ class HBMCtrl : public MemCtrl
     virtual void init() override;
     virtual void startup() override;
     virtual void drainResume() override;
+    void resetStats() override;
 
 
   protected:
@@ -94,7 +94,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -129,6 +129,15 @@ class HeteroMemCtrl : public MemCtrl
     DrainState drain() override;
     void drainResume() override;
 
+    /**
+     * The NVM interface shares the scheduler with the DRAM, which must
+     * therefore keep refreshing even when it has nothing queued.
+     */
+    bool isIdle(const MemInterface* mem_intr) const override
+    {
+        return false;
+    }
+
   protected:
 
     Tick recvAtomic(PacketPtr pkt) override;
@@ -486,7 +486,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -779,6 +779,22 @@ MemCtrl::inReadBusState(bool next_state, const MemInterface* mem_intr) const
     }
 }
 
+bool
+MemCtrl::isIdle(const MemInterface* mem_intr) const
+{
+    return !turnPolicy && drainState() == DrainState::Running &&
+        mem_intr->readQueueSize == 0 && mem_intr->writeQueueSize == 0 &&
+        !respondEventScheduled(mem_intr->pseudoChannel) &&
+        inReadBusState(false, mem_intr) && inReadBusState(true, mem_intr);
+}
+
+void
+MemCtrl::recordIdleRestarts(uint64_t count)
+{
+    // an idle scheduler stays in the read state, see processNextReqEvent
+    qos::MemCtrl::stats.numStayReadState += count;
+}
+
 bool
 MemCtrl::inWriteBusState(bool next_state, const MemInterface* mem_intr) const
 {
@@ -879,7 +895,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -1466,6 +1482,16 @@ MemCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+void
+MemCtrl::resetStats()
+{
+    // account for the refreshes skipped while idle before they are
+    // lost in the reset
+    dram->catchUpRefresh(false);
+
+    qos::MemCtrl::resetStats();
+}
+
 AddrRangeList
 MemCtrl::getAddrRanges()
 {
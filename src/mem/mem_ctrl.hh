@@ -46,6 +46,7 @@
 #ifndef __MEM_CTRL_HH__
 #define __MEM_CTRL_HH__
 
+#include <cstdint>
 #include <deque>
 #include <string>
 #include <unordered_set>
@@ -55,6 +56,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_packet_queue.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -215,11 +217,6 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
-
-
 /**
  * The memory controller is a single-channel memory controller capturing
  * the most important timing constraints associated with a
@@ -300,14 +297,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -772,12 +769,33 @@ class MemCtrl : public qos::MemCtrl
      */
     bool inWriteBusState(bool next_state, const MemInterface* mem_intr) const;
 
+    /**
+     * Check if restarting the scheduler for a memory interface would
+     * have no effect other than recording a read to read turnaround,
+     * i.e. nothing is queued, no response is pending, the bus stays in
+     * the read state and no turnaround policy is in use. Interfaces may
+     * then skip their maintenance events while idle, as long as they
+     * account for the restarts using recordIdleRestarts().
+     *
+     * @param mem_intr Memory interface to check
+     * @return true if the interface is idle
+     */
+    virtual bool isIdle(const MemInterface* mem_intr) const;
+
+    /**
+     * Account for scheduler restarts that were skipped while idle.
+     *
+     * @param count Number of restarts
+     */
+    void recordIdleRestarts(uint64_t count);
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
     virtual void init() override;
     virtual void startup() override;
     virtual void drainResume() override;
+    void resetStats() override;
 
   protected:
 
@@ -385,6 +385,12 @@ class MemInterface : public AbstractMemory
         "not be executed from here.\n");
     }
 
+    /**
+     * This function is DRAM specific. Interfaces that do not skip
+     * any maintenance events while idle have nothing to do.
+     */
+    virtual void catchUpRefresh(bool resume) {}
+
     /**
      * This function is NVM specific.
      */
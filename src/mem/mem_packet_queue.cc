@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/mem_packet_queue.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "mem/mem_ctrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    const iterator pos = packets.insert(packets.end(), pkt);
+
+    Bank &bank = banks[bankKey(pkt->pseudoChannel, pkt->rank, pkt->bank)];
+    if (bank.entries.empty()) {
+        bank.rank = pkt->rank;
+        bank.bank = pkt->bank;
+        if (active.size() <= pkt->pseudoChannel)
+            active.resize(pkt->pseudoChannel + 1);
+        bank.activeIndex = active[pkt->pseudoChannel].size();
+        active[pkt->pseudoChannel].push_back(&bank);
+    }
+    bank.entries.push_back({nextSeq++, pos});
+    if (pkt->isDram())
+        ++bank.numDram;
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator pos)
+{
+    const MemPacket *pkt = *pos;
+    Bank &bank = banks.at(bankKey(pkt->pseudoChannel, pkt->rank, pkt->bank));
+    auto entry = std::find_if(bank.entries.begin(), bank.entries.end(),
+        [pos](const Entry &e) { return e.pos == pos; });
+    assert(entry != bank.entries.end());
+    bank.entries.erase(entry);
+    if (pkt->isDram())
+        --bank.numDram;
+
+    if (bank.entries.empty()) {
+        // Move the last active bank into the place of this one
+        auto &channel = active[pkt->pseudoChannel];
+        channel[bank.activeIndex] = channel.back();
+        channel[bank.activeIndex]->activeIndex = bank.activeIndex;
+        channel.pop_back();
+    }
+
+    return packets.erase(pos);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_MEM_PACKET_QUEUE_HH__
+#define __MEM_MEM_PACKET_QUEUE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class MemPacket;
+
+/**
+ * The memory packets waiting to be scheduled at one QoS priority, in
+ * arrival order. The controller keeps one such queue per priority.
+ *
+ * Besides the arrival order, the packets are indexed by the bank they
+ * target. The FR-FCFS schedulers then only look at the banks that have
+ * packets queued, and at the few packets of each of these banks, rather
+ * than walking the whole queue for every scheduling decision. Packets of
+ * different banks are ordered by the sequence number they get when they
+ * are queued.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::list<MemPacket*>::iterator iterator;
+    typedef std::list<MemPacket*>::const_iterator const_iterator;
+
+    /** A queued packet, as seen from its bank. */
+    struct Entry
+    {
+        /** Arrival order of the packet in the queue */
+        uint64_t seq;
+
+        /** Position of the packet in the queue */
+        iterator pos;
+    };
+
+    /** The queued packets of a bank. */
+    struct Bank
+    {
+        uint8_t rank;
+        uint8_t bank;
+
+        /** The packets targeting the bank, oldest first */
+        std::vector<Entry> entries;
+
+        /** Number of entries that access DRAM */
+        unsigned numDram = 0;
+
+        /** Position of the bank in the active banks of its channel */
+        size_t activeIndex = 0;
+    };
+
+  private:
+    std::list<MemPacket*> packets;
+
+    /** All banks that ever had a packet queued, by bankKey() */
+    std::unordered_map<uint32_t, Bank> banks;
+
+    /** Banks with packets queued, per pseudo channel */
+    std::vector<std::vector<Bank*>> active;
+
+    uint64_t nextSeq = 0;
+
+    static uint32_t
+    bankKey(uint8_t pseudo_channel, uint8_t rank, uint8_t bank)
+    {
+        return (uint32_t(pseudo_channel) << 16) | (uint32_t(rank) << 8) |
+            bank;
+    }
+
+  public:
+    MemPacketQueue() = default;
+    MemPacketQueue(MemPacketQueue &&other) = default;
+    MemPacketQueue(const MemPacketQueue &other) = delete;
+    MemPacketQueue &operator=(const MemPacketQueue &other) = delete;
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+    MemPacket *front() const { return packets.front(); }
+
+    /** Queue a packet at the back. */
+    void push_back(MemPacket *pkt);
+
+    /**
+     * Remove a packet from the queue.
+     *
+     * @param pos The position of the packet.
+     * @return The position of the next packet.
+     */
+    iterator erase(iterator pos);
+
+    /**
+     * Get the banks of a pseudo channel that have packets queued, in no
+     * particular order.
+     */
+    const std::vector<Bank*> &
+    activeBanks(uint8_t pseudo_channel) const
+    {
+        static const std::vector<Bank*> none;
+        return pseudo_channel < active.size() ? active[pseudo_channel] : none;
+    }
+
+    /**
+     * Get the queued packets of a bank.
+     *
+     * @return The bank, or nullptr if it has no packets queued.
+     */
+    const Bank *
+    findBank(uint8_t pseudo_channel, uint8_t rank, uint8_t bank) const
+    {
+        auto it = banks.find(bankKey(pseudo_channel, rank, bank));
+        return it == banks.end() || it->second.entries.empty() ?
+            nullptr : &it->second;
+    }
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_MEM_PACKET_QUEUE_HH__
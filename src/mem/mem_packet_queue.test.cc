@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/types.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/mem_packet_queue.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+constexpr unsigned numRanks = 2;
+constexpr unsigned banksPerRank = 8;
+constexpr uint32_t noRow = UINT32_MAX;
+
+/**
+ * The state of the banks, as seen by the DRAM FR-FCFS scheduler. The
+ * banks that minBankPrep() selects are given as a mask, since only the
+ * way the scheduler combines them with the queue is of interest here.
+ */
+struct BankState
+{
+    bool idle[numRanks];
+    uint32_t openRow[numRanks][banksPerRank];
+    Tick colAllowedAt[numRanks][banksPerRank];
+    std::vector<uint32_t> earliestBanks;
+    bool hiddenBankPrep;
+};
+
+typedef std::pair<MemPacketQueue::iterator, Tick> Choice;
+
+/**
+ * FR-FCFS as it was done before the queue was indexed by bank, walking
+ * the whole queue in arrival order.
+ */
+Choice
+chooseByWalk(MemPacketQueue &queue, uint8_t pseudo_channel,
+             const BankState &state, Tick min_col_at)
+{
+    bool found_hidden_bank = false;
+    bool found_prepped_pkt = false;
+    bool found_earliest_pkt = false;
+    Tick selected_col_at = MaxTick;
+    auto selected_pkt_it = queue.end();
+
+    for (auto i = queue.begin(); i != queue.end(); ++i) {
+        const MemPacket *pkt = *i;
+        if (!pkt->isDram() || pkt->pseudoChannel != pseudo_channel ||
+            !state.idle[pkt->rank]) {
+            continue;
+        }
+
+        const Tick col_allowed_at = state.colAllowedAt[pkt->rank][pkt->bank];
+        if (state.openRow[pkt->rank][pkt->bank] == pkt->row) {
+            if (col_allowed_at <= min_col_at) {
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                break;
+            } else if (!found_hidden_bank && !found_prepped_pkt) {
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                found_prepped_pkt = true;
+            }
+        } else if (!found_earliest_pkt &&
+                   (state.earliestBanks[pkt->rank] >> pkt->bank) & 1) {
+            found_earliest_pkt = true;
+            found_hidden_bank = state.hiddenBankPrep;
+            if (state.hiddenBankPrep || !found_prepped_pkt) {
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+            }
+        }
+    }
+
+    return std::make_pair(selected_pkt_it, selected_col_at);
+}
+
+/** FR-FCFS using the bank index, as DRAMInterface does. */
+Choice
+chooseByBank(MemPacketQueue &queue, uint8_t pseudo_channel,
+             const BankState &state, Tick min_col_at)
+{
+    const MemPacketQueue::Entry *seamless_hit = nullptr;
+    Tick seamless_col_at = MaxTick;
+    const MemPacketQueue::Entry *prepped_hit = nullptr;
+    Tick prepped_col_at = MaxTick;
+    bool got_miss = false;
+
+    const auto &banks = queue.activeBanks(pseudo_channel);
+    for (const auto *queued : banks) {
+        if (!queued->numDram || !state.idle[queued->rank]) {
+            continue;
+        }
+
+        for (const auto &entry : queued->entries) {
+            const MemPacket *pkt = *entry.pos;
+            if (!pkt->isDram()) {
+                continue;
+            }
+            if (state.openRow[queued->rank][queued->bank] != pkt->row) {
+                got_miss = true;
+                continue;
+            }
+
+            const Tick col_allowed_at =
+                state.colAllowedAt[queued->rank][queued->bank];
+            if (col_allowed_at <= min_col_at) {
+                if (!seamless_hit || entry.seq < seamless_hit->seq) {
+                    seamless_hit = &entry;
+                    seamless_col_at = col_allowed_at;
+                }
+                break;
+            } else if (!prepped_hit || entry.seq < prepped_hit->seq) {
+                prepped_hit = &entry;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
+
+    if (seamless_hit) {
+        return std::make_pair(seamless_hit->pos, seamless_col_at);
+    }
+
+    const MemPacketQueue::Entry *earliest_miss = nullptr;
+    Tick earliest_col_at = MaxTick;
+    if (got_miss) {
+        for (const auto *queued : banks) {
+            if (!queued->numDram || !state.idle[queued->rank] ||
+                !((state.earliestBanks[queued->rank] >> queued->bank) & 1)) {
+                continue;
+            }
+
+            for (const auto &entry : queued->entries) {
+                const MemPacket *pkt = *entry.pos;
+                if (!pkt->isDram() ||
+                    state.openRow[queued->rank][queued->bank] == pkt->row) {
+                    continue;
+                }
+                if (!earliest_miss || entry.seq < earliest_miss->seq) {
+                    earliest_miss = &entry;
+                    earliest_col_at =
+                        state.colAllowedAt[queued->rank][queued->bank];
+                }
+                break;
+            }
+        }
+    }
+
+    if (earliest_miss && (state.hiddenBankPrep || !prepped_hit)) {
+        return std::make_pair(earliest_miss->pos, earliest_col_at);
+    } else if (prepped_hit) {
+        return std::make_pair(prepped_hit->pos, prepped_col_at);
+    }
+    return std::make_pair(queue.end(), MaxTick);
+}
+
+class MemPacketQueueTest : public testing::Test
+{
+  protected:
+    std::mt19937_64 rng{1};
+    RequestPtr req = std::make_shared<Request>(0, 64, 0, 0);
+    Packet pkt{req, MemCmd::ReadReq};
+    std::vector<MemPacketQueue> queues;
+
+    MemPacketQueueTest() : queues(2) {}
+
+    ~MemPacketQueueTest()
+    {
+        for (auto &queue : queues) {
+            for (auto *mem_pkt : queue) {
+                delete mem_pkt;
+            }
+        }
+    }
+
+    unsigned random(unsigned n) { return rng() % n; }
+
+    MemPacket *
+    newPacket()
+    {
+        const uint8_t rank = random(numRanks);
+        const uint8_t bank = random(banksPerRank);
+        return new MemPacket(&pkt, true, random(8) != 0,
+                             random(4) == 0 ? 1 : 0, rank, bank, random(4),
+                             rank * banksPerRank + bank, 0, 64);
+    }
+
+    /**
+     * Randomly add packets to the queues, remove some, and move others
+     * between queues as QoS escalation does.
+     */
+    MemPacketQueue &
+    step()
+    {
+        MemPacketQueue &queue = queues[random(2)];
+        if (queue.size() < 40 && random(2) == 0) {
+            queue.push_back(newPacket());
+        }
+        if (!queue.empty() && random(4) == 0) {
+            auto it = queue.begin();
+            std::advance(it, random(queue.size()));
+            MemPacket *mem_pkt = *it;
+            queue.erase(it);
+            MemPacketQueue &target = queues[random(2)];
+            if (target.size() < 40 && random(2) == 0) {
+                target.push_back(mem_pkt);
+            } else {
+                delete mem_pkt;
+            }
+        }
+        return queue;
+    }
+};
+
+} // anonymous namespace
+
+/** The bank index always matches the packets of the queue. */
+TEST_F(MemPacketQueueTest, BankIndex)
+{
+    for (int i = 0; i < 20000; i++) {
+        const MemPacketQueue &queue = step();
+
+        for (uint8_t channel = 0; channel < 2; channel++) {
+            size_t num_active = 0;
+            for (uint8_t rank = 0; rank < numRanks; rank++) {
+                for (uint8_t bank = 0; bank < banksPerRank; bank++) {
+                    std::vector<const MemPacket *> expected;
+                    unsigned num_dram = 0;
+                    for (const auto *mem_pkt : queue) {
+                        if (mem_pkt->pseudoChannel == channel &&
+                            mem_pkt->rank == rank && mem_pkt->bank == bank) {
+                            expected.push_back(mem_pkt);
+                            num_dram += mem_pkt->isDram();
+                        }
+                    }
+
+                    const auto *queued =
+                        queue.findBank(channel, rank, bank);
+                    if (expected.empty()) {
+                        ASSERT_EQ(queued, nullptr);
+                        continue;
+                    }
+                    ASSERT_NE(queued, nullptr);
+                    num_active++;
+
+                    ASSERT_EQ(queued->rank, rank);
+                    ASSERT_EQ(queued->bank, bank);
+                    ASSERT_EQ(queued->numDram, num_dram);
+                    ASSERT_EQ(queued->entries.size(), expected.size());
+                    for (size_t e = 0; e < expected.size(); e++) {
+                        ASSERT_EQ(*queued->entries[e].pos, expected[e]);
+                        if (e) {
+                            ASSERT_LT(queued->entries[e - 1].seq,
+                                      queued->entries[e].seq);
+                        }
+                    }
+
+                    const auto &active = queue.activeBanks(channel);
+                    ASSERT_NE(std::find(active.begin(), active.end(),
+                                        queued), active.end());
+                }
+            }
+            ASSERT_EQ(queue.activeBanks(channel).size(), num_active);
+        }
+    }
+}
+
+/**
+ * Picking packets through the bank index gives the same packet and
+ * column time as walking the whole queue, for random queues and bank
+ * states.
+ */
+TEST_F(MemPacketQueueTest, FRFCFSEquivalence)
+{
+    BankState state;
+    state.earliestBanks.resize(numRanks);
+
+    unsigned num_picked = 0;
+    for (int i = 0; i < 200000; i++) {
+        MemPacketQueue &queue = step();
+
+        for (unsigned rank = 0; rank < numRanks; rank++) {
+            state.idle[rank] = random(5) != 0;
+            state.earliestBanks[rank] = rng();
+            for (unsigned bank = 0; bank < banksPerRank; bank++) {
+                state.openRow[rank][bank] =
+                    random(5) == 0 ? noRow : random(4);
+                state.colAllowedAt[rank][bank] = random(100);
+            }
+        }
+        state.hiddenBankPrep = random(2);
+        const Tick min_col_at = random(100);
+        const uint8_t channel = random(4) == 0 ? 1 : 0;
+
+        const Choice walked = chooseByWalk(queue, channel, state, min_col_at);
+        const Choice by_bank =
+            chooseByBank(queue, channel, state, min_col_at);
+        ASSERT_TRUE(walked.first == by_bank.first) << "step " << i;
+        ASSERT_EQ(walked.second, by_bank.second) << "step " << i;
+
+        if (walked.first != queue.end()) {
+            num_picked++;
+            if (random(2) == 0) {
+                delete *walked.first;
+                queue.erase(walked.first);
+            }
+        }
+    }
+
+    // Make sure the queues did not stay empty, or all blocked
+    EXPECT_GT(num_picked, 10000);
+}
@@ -58,6 +58,7 @@
 #include "base/extensible.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_alloc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -419,6 +420,16 @@ class Packet : public Printable, public Extensible<Packet>
      */
     uint64_t htmTransactionUid;
 
+    /**
+     * Payloads up to this size are stored in the packet itself rather
+     * than in a separate heap allocation. This covers a full cache
+     * line for the common 64 byte line size.
+     */
+    static constexpr unsigned InlineDataSize = 64;
+
+    /** Storage for small dynamically allocated payloads. */
+    alignas(8) uint8_t inlineData[InlineDataSize];
+
   public:
 
     /**
@@ -1054,6 +1065,27 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * Packets are allocated from a per-thread pool to avoid the cost of
+     * going through malloc for every memory access.
+     * @{
+     */
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return pool_alloc::FixedSizePool<sizeof(Packet),
+                                         alignof(Packet)>::allocate();
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        pool_alloc::FixedSizePool<sizeof(Packet),
+                                  alignof(Packet)>::deallocate(p);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1355,7 +1387,7 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(DYNAMIC_DATA) && data != inlineData)
             delete [] data;
 
         flags.clear(STATIC_DATA|DYNAMIC_DATA);
@@ -1371,7 +1403,8 @@ class Packet : public Printable, public Extensible<Packet>
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            data = getSize() <= InlineDataSize ?
+                inlineData : new uint8_t[getSize()];
         }
     }
 
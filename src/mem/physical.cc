@@ -39,25 +39,40 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 #include "base/intmath.hh"
 #include "base/trace.hh"
+#include "config/have_zstd.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
+#if HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
  * without committing to actually providing the swap space on the
@@ -80,10 +95,14 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               MemoryCheckpointFormat checkpoint_format,
+                               unsigned checkpoint_threads) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), checkpointFormat(checkpoint_format),
+    checkpointThreads(checkpoint_threads ? checkpoint_threads :
+                      std::max(1u, std::thread::hardware_concurrency()))
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -193,6 +212,8 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                            f->isConfReported(), f->isInAddrMap(),
                            f->isKvmMap());
     }
+
+    lastPageImage.resize(backingStore.size());
 }
 
 void
@@ -363,10 +384,31 @@ void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
 {
+    std::string format;
+    std::string extension;
+    switch (checkpointFormat) {
+      case MemoryCheckpointFormat::pages:
+        format = "pages";
+        extension = ".pidx";
+        break;
+      case MemoryCheckpointFormat::chunked:
+        format = "chunked";
+        extension = ".pmemc";
+        break;
+      case MemoryCheckpointFormat::raw:
+        format = "raw";
+        extension = ".raw";
+        break;
+      default:
+        format = "gzip";
+        extension = ".pmem";
+        break;
+    }
+
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
     std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+        name() + ".store" + std::to_string(store_id) + extension;
     long range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
@@ -375,13 +417,34 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    switch (checkpointFormat) {
+      case MemoryCheckpointFormat::pages:
+        serializeStorePages(filepath, store_id, range, pmem);
+        break;
+      case MemoryCheckpointFormat::chunked:
+        serializeStoreChunked(filepath, range, pmem);
+        break;
+      case MemoryCheckpointFormat::raw:
+        serializeStoreRaw(filepath, range, pmem);
+        break;
+      default:
+        serializeStoreGzip(filepath, range, pmem);
+        break;
+    }
+}
+
+void
+PhysicalMemory::serializeStoreGzip(const std::string &filepath,
+                                   AddrRange range, uint8_t* pmem) const
+{
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
 
     uint64_t pass_size = 0;
 
@@ -394,7 +457,7 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
         if (gzwrite(compressed_mem, pmem + written,
                     (unsigned int) pass_size) != (int) pass_size) {
             fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+                  filepath);
         }
     }
 
@@ -402,8 +465,734 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     // is zero
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
+
+}
+
+namespace
+{
+
+/**
+ * A page image consists of an index file and a data file. The index
+ * starts with a header followed by the path of the parent index, if
+ * any, relative to the directory of the index, and one entry per page.
+ * An entry is either ZeroPage, ParentPage (the page is identical to
+ * the page at the same address in the parent image) or FirstDataPage
+ * plus the number of the page in the data file. The data file holds
+ * the unique non-zero pages back to back, so that they can be mapped
+ * directly.
+ */
+const char PageIndexMagic[8] = {'g', 'e', 'm', '5', 'p', 'i', 'd', 'x'};
+const uint64_t PageIndexVersion = 1;
+
+const uint64_t ZeroPage = 0;
+const uint64_t ParentPage = 1;
+const uint64_t FirstDataPage = 2;
+
+/** Restores with more runs than this are copied rather than mapped. */
+const size_t MaxMappedRuns = 16384;
+
+struct PageIndexHeader
+{
+    char magic[8];
+    uint64_t version;
+    uint64_t pageSize;
+    uint64_t numPages;
+    uint64_t numDataPages;
+    uint64_t parentLength;
+};
+
+std::string
+pageDataPath(const std::string &index_path)
+{
+    const std::string ext = ".pidx";
+    std::string path = index_path;
+    if (path.size() >= ext.size() &&
+        path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+        path.resize(path.size() - ext.size());
+    }
+    return path + ".pdat";
+}
+
+/**
+ * Checkpoint files are written to a temporary file, which is then
+ * renamed over the final one. The file that is replaced may still be
+ * mapped as the backing store of the memory restored from it, and
+ * truncating it would pull the pages out from under that mapping.
+ */
+std::string
+tempPath(const std::string &path)
+{
+    return path + ".tmp";
+}
+
+void
+replaceFile(const std::string &tmp_path, const std::string &path)
+{
+    fatal_if(rename(tmp_path.c_str(), path.c_str()) != 0,
+             "Can't rename '%s' to '%s': %s\n", tmp_path, path,
+             strerror(errno));
+}
+
+/**
+ * A page image on disk together with its chain of parents. The data
+ * files are mapped read-only so that looking up a page does not
+ * require reading the whole image.
+ */
+class PageImage
+{
+  public:
+    explicit PageImage(const std::string &index_path);
+    ~PageImage();
+
+    PageImage(const PageImage &) = delete;
+    PageImage &operator=(const PageImage &) = delete;
+
+    uint64_t pageSize() const { return header.pageSize; }
+    uint64_t numPages() const { return header.numPages; }
+    int dataFd() const { return fd; }
+
+    /**
+     * Check if this image or any of its parents is stored in the
+     * given index file.
+     *
+     * @param index_path Canonical path of an index file.
+     */
+    bool uses(const std::filesystem::path &index_path) const;
+
+    /**
+     * Find the image that holds the contents of a page.
+     *
+     * @param page Page number in the backing store.
+     * @param data_page Set to the page number in the data file of the
+     *                  returned image.
+     * @return The image holding the page, nullptr for a zero page.
+     */
+    const PageImage *lookup(uint64_t page, uint64_t &data_page) const;
+
+    const uint8_t *
+    data(uint64_t data_page) const
+    {
+        return dataMap + data_page * header.pageSize;
+    }
+
+  private:
+    const std::string path;
+    PageIndexHeader header;
+    std::vector<uint64_t> entries;
+    std::unique_ptr<PageImage> parent;
+    int fd;
+    uint8_t *dataMap;
+};
+
+PageImage::PageImage(const std::string &index_path)
+    : path(index_path), fd(-1), dataMap(nullptr)
+{
+    std::ifstream index(path, std::ios::binary);
+    fatal_if(!index, "Can't open page image index '%s'\n", path);
+
+    index.read((char *)&header, sizeof(header));
+    fatal_if(!index || memcmp(header.magic, PageIndexMagic,
+                              sizeof(PageIndexMagic)) != 0,
+             "'%s' is not a page image index\n", path);
+    fatal_if(header.version != PageIndexVersion,
+             "Unsupported page image version %d in '%s'\n",
+             header.version, path);
+
+    std::string parent_path(header.parentLength, '\0');
+    entries.resize(header.numPages);
+    index.read(&parent_path[0], header.parentLength);
+    index.read((char *)entries.data(),
+               entries.size() * sizeof(entries[0]));
+    fatal_if(!index, "Truncated page image index '%s'\n", path);
+
+    if (!parent_path.empty()) {
+        // the parent is relative to the directory of this image, so
+        // that checkpoint directories can be moved together
+        const std::filesystem::path parent_index =
+            std::filesystem::path(path).parent_path() / parent_path;
+        DPRINTF(Checkpoint, "Page image %s has parent %s\n",
+                path, parent_index);
+        parent.reset(new PageImage(parent_index.string()));
+        fatal_if(parent->pageSize() != pageSize() ||
+                 parent->numPages() != numPages(),
+                 "Page image '%s' does not match its parent '%s'\n",
+                 path, parent_path);
+    }
+
+    if (header.numDataPages == 0)
+        return;
+
+    const std::string data_path = pageDataPath(path);
+    fd = open(data_path.c_str(), O_RDONLY);
+    fatal_if(fd == -1, "Can't open page image data '%s'\n", data_path);
+
+    void *map = mmap(NULL, header.numDataPages * header.pageSize,
+                     PROT_READ, MAP_PRIVATE, fd, 0);
+    fatal_if(map == MAP_FAILED, "Can't map page image data '%s'\n",
+             data_path);
+    dataMap = (uint8_t *)map;
+}
+
+PageImage::~PageImage()
+{
+    if (dataMap)
+        munmap(dataMap, header.numDataPages * header.pageSize);
+    if (fd != -1)
+        close(fd);
+}
+
+bool
+PageImage::uses(const std::filesystem::path &index_path) const
+{
+    for (const PageImage *image = this; image; image = image->parent.get()) {
+        if (std::filesystem::weakly_canonical(image->path) == index_path)
+            return true;
+    }
+    return false;
+}
+
+const PageImage *
+PageImage::lookup(uint64_t page, uint64_t &data_page) const
+{
+    const PageImage *image = this;
+    while (true) {
+        const uint64_t entry = image->entries[page];
+        if (entry == ZeroPage)
+            return nullptr;
+
+        if (entry != ParentPage) {
+            data_page = entry - FirstDataPage;
+            fatal_if(data_page >= image->header.numDataPages,
+                     "Corrupt page image index '%s'\n", image->path);
+            return image;
+        }
+
+        fatal_if(!image->parent, "Corrupt page image index '%s'\n",
+                 image->path);
+        image = image->parent.get();
+    }
+}
+
+/**
+ * Hash a page, a word at a time, and report whether it is all zero.
+ */
+uint64_t
+hashPage(const uint8_t *page, uint64_t page_size, bool &zero)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint64_t any = 0;
+    for (uint64_t i = 0; i < page_size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, page + i, sizeof(word));
+        any |= word;
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    zero = any == 0;
+    return hash;
+}
+
+/**
+ * A chunked image starts with a header and a table with the offset
+ * and compressed size of every chunk, followed by the compressed
+ * chunks. Chunks that are all zero have a size of zero and no data.
+ */
+const char ChunkedMagic[8] = {'g', 'e', 'm', '5', 'p', 'm', 'e', 'c'};
+const uint64_t ChunkedVersion = 1;
+
+/** Size of a chunk, large enough to compress well. */
+const uint64_t ChunkSize = 4 * 1024 * 1024;
+
+enum ChunkCodec : uint32_t
+{
+    CodecZlib = 0,
+    CodecZstd = 1,
+};
+
+struct ChunkedHeader
+{
+    char magic[8];
+    uint64_t version;
+    uint32_t codec;
+    uint32_t reserved;
+    uint64_t chunkSize;
+    uint64_t rangeSize;
+    uint64_t numChunks;
+};
+
+struct ChunkEntry
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
+bool
+isZero(const uint8_t *data, uint64_t size)
+{
+    uint64_t any = 0;
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        any |= word;
+    }
+    for (; i < size; ++i)
+        any |= data[i];
+    return any == 0;
+}
+
+bool
+compressChunk(uint32_t codec, const uint8_t *src, uint64_t size,
+              std::vector<uint8_t> &dst)
+{
+#if HAVE_ZSTD
+    if (codec == CodecZstd) {
+        dst.resize(ZSTD_compressBound(size));
+        const size_t ret = ZSTD_compress(dst.data(), dst.size(), src, size, 1);
+        if (ZSTD_isError(ret))
+            return false;
+        dst.resize(ret);
+        return true;
+    }
+#endif
+    uLongf dst_size = compressBound(size);
+    dst.resize(dst_size);
+    if (compress2(dst.data(), &dst_size, src, size, Z_BEST_SPEED) != Z_OK)
+        return false;
+    dst.resize(dst_size);
+    return true;
+}
+
+bool
+decompressChunk(uint32_t codec, const uint8_t *src, uint64_t size,
+                uint8_t *dst, uint64_t dst_size)
+{
+#if HAVE_ZSTD
+    if (codec == CodecZstd) {
+        return ZSTD_decompress(dst, dst_size, src, size) == dst_size;
+    }
+#endif
+    uLongf len = dst_size;
+    return uncompress(dst, &len, src, size) == Z_OK && len == dst_size;
+}
+
+bool
+readAt(int fd, void *buf, uint64_t size, uint64_t offset)
+{
+    uint8_t *dst = (uint8_t *)buf;
+    while (size) {
+        const ssize_t ret = pread(fd, dst, size, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        dst += ret;
+        size -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+/**
+ * Call a function for every index in [0, n) using a number of host
+ * threads, including the calling one.
+ */
+void
+parallelFor(uint64_t n, unsigned threads,
+            const std::function<void(uint64_t)> &fn)
+{
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            fn(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (uint64_t t = 1; t < std::min<uint64_t>(threads, n); ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &t : workers)
+        t.join();
+}
+
+bool
+writeAt(int fd, const void *buf, uint64_t size, uint64_t offset)
+{
+    const uint8_t *src = (const uint8_t *)buf;
+    while (size) {
+        const ssize_t ret = pwrite(fd, src, size, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        src += ret;
+        size -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int
+PhysicalMemory::restoreMapFlags() const
+{
+    return MAP_PRIVATE | MAP_FIXED | (mmapUsingNoReserve ? MAP_NORESERVE : 0);
+}
+
+void
+PhysicalMemory::serializeStoreRaw(const std::string &filepath,
+                                  AddrRange range, uint8_t* pmem) const
+{
+    const uint64_t range_size = range.size();
+    const uint64_t page_size = pageSize;
+
+    // The image being replaced may be mapped by the current backing
+    // store, so write a new file rather than truncating it
+    const std::string tmp_path = tempPath(filepath);
+    const int fd = open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY,
+                        0666);
+    fatal_if(fd == -1, "Can't open physical memory checkpoint file '%s'\n",
+             tmp_path);
+
+    // Zero pages are left as holes in the file so that the image only
+    // takes up space for the memory actually in use
+    bool ok = ftruncate(fd, range_size) == 0;
+    uint64_t run_start = 0;
+    uint64_t run_end = 0;
+    for (uint64_t off = 0; ok && off < range_size; off += page_size) {
+        const uint64_t len = std::min(page_size, range_size - off);
+        if (isZero(pmem + off, len))
+            continue;
+
+        if (off != run_end) {
+            ok = writeAt(fd, pmem + run_start, run_end - run_start,
+                         run_start);
+            run_start = off;
+        }
+        run_end = off + len;
+    }
+    if (ok)
+        ok = writeAt(fd, pmem + run_start, run_end - run_start, run_start);
+
+    if (close(fd) != 0)
+        ok = false;
+    fatal_if(!ok, "Write failed on physical memory checkpoint file '%s'\n",
+             tmp_path);
+    replaceFile(tmp_path, filepath);
+}
+
+void
+PhysicalMemory::unserializeStoreRaw(const std::string &filepath,
+                                    unsigned int store_id)
+{
+    const BackingStoreEntry &store = backingStore[store_id];
+    const uint64_t range_size = store.range.size();
+    const uint64_t page_size = pageSize;
+
+    const int fd = open(filepath.c_str(), O_RDONLY);
+    fatal_if(fd == -1, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) != 0 || (uint64_t)st.st_size != range_size,
+             "Raw memory image '%s' does not match the memory size\n",
+             filepath);
+
+    // Map the whole pages of the image over a private backing store,
+    // and read the rest
+    uint64_t mapped = 0;
+    if (store.shmFd == -1) {
+        mapped = range_size / page_size * page_size;
+        if (mapped) {
+            void *addr = mmap(store.pmem, mapped, PROT_READ | PROT_WRITE,
+                              restoreMapFlags(), fd, 0);
+            if (addr == MAP_FAILED) {
+                perror("mmap");
+                fatal("Could not map raw memory image '%s'\n", filepath);
+            }
+        }
+    }
+
+    DPRINTF(Checkpoint, "Mapped %d of %d bytes of %s\n", mapped,
+            range_size, filepath);
+
+    // Only copy pages that are non-zero, so we don't give the VM
+    // system hell
+    std::vector<uint8_t> page(page_size);
+    for (uint64_t off = mapped; off < range_size; off += page_size) {
+        const uint64_t len = std::min(page_size, range_size - off);
+        fatal_if(!readAt(fd, page.data(), len, off),
+                 "Read failed on raw memory image '%s'\n", filepath);
+        if (!isZero(page.data(), len))
+            memcpy(store.pmem + off, page.data(), len);
+    }
+
+    close(fd);
+}
+
+void
+PhysicalMemory::serializeStoreChunked(const std::string &filepath,
+                                      AddrRange range, uint8_t* pmem) const
+{
+    ChunkedHeader header;
+    memcpy(header.magic, ChunkedMagic, sizeof(ChunkedMagic));
+    header.version = ChunkedVersion;
+    header.codec = HAVE_ZSTD ? CodecZstd : CodecZlib;
+    header.reserved = 0;
+    header.chunkSize = ChunkSize;
+    header.rangeSize = range.size();
+    header.numChunks = divCeil(header.rangeSize, ChunkSize);
+
+    std::vector<ChunkEntry> table(header.numChunks);
+
+    std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+    fatal_if(!out, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    // the table is filled in once all chunks are written
+    const uint64_t table_size = table.size() * sizeof(table[0]);
+    out.write((const char *)&header, sizeof(header));
+    out.write((const char *)table.data(), table_size);
+    uint64_t offset = sizeof(header) + table_size;
+
+    // compress a few chunks per thread at a time to bound the memory
+    // needed for the compressed data
+    const uint64_t batch = checkpointThreads * 4;
+    std::vector<std::vector<uint8_t>> buffers(batch);
+    std::atomic<bool> failed(false);
+    for (uint64_t first = 0; first < header.numChunks; first += batch) {
+        const uint64_t count = std::min(batch, header.numChunks - first);
+        parallelFor(count, checkpointThreads, [&](uint64_t i) {
+            const uint64_t start = (first + i) * ChunkSize;
+            const uint64_t size =
+                std::min(ChunkSize, header.rangeSize - start);
+            buffers[i].clear();
+            if (!isZero(pmem + start, size) &&
+                !compressChunk(header.codec, pmem + start, size,
+                               buffers[i])) {
+                failed = true;
+            }
+        });
+        fatal_if(failed, "Compression failed for physical memory "
+                 "checkpoint file '%s'\n", filepath);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            table[first + i].offset = offset;
+            table[first + i].size = buffers[i].size();
+            out.write((const char *)buffers[i].data(), buffers[i].size());
+            offset += buffers[i].size();
+        }
+    }
+
+    out.seekp(sizeof(header));
+    out.write((const char *)table.data(), table_size);
+    out.close();
+    fatal_if(out.fail(),
+             "Write failed on physical memory checkpoint file '%s'\n",
+             filepath);
+
+    DPRINTF(Checkpoint, "Wrote %d chunks of %d bytes using %s\n",
+            header.numChunks, ChunkSize,
+            header.codec == CodecZstd ? "zstd" : "zlib");
+}
+
+void
+PhysicalMemory::unserializeStoreChunked(const std::string &filepath,
+                                        uint8_t* pmem, AddrRange range)
+{
+    const int fd = open(filepath.c_str(), O_RDONLY);
+    fatal_if(fd == -1, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    ChunkedHeader header;
+    fatal_if(!readAt(fd, &header, sizeof(header), 0) ||
+             memcmp(header.magic, ChunkedMagic, sizeof(ChunkedMagic)) != 0,
+             "'%s' is not a chunked memory image\n", filepath);
+    fatal_if(header.version != ChunkedVersion,
+             "Unsupported chunked memory image version %d in '%s'\n",
+             header.version, filepath);
+    fatal_if(header.rangeSize != range.size(),
+             "Chunked memory image '%s' does not match the memory size\n",
+             filepath);
+    fatal_if(header.codec == CodecZstd && !HAVE_ZSTD,
+             "'%s' is compressed with zstd, which this build of gem5 "
+             "does not support\n", filepath);
+    fatal_if(header.codec != CodecZstd && header.codec != CodecZlib,
+             "Unknown codec %d in '%s'\n", header.codec, filepath);
+    fatal_if(header.numChunks != divCeil(header.rangeSize, header.chunkSize),
+             "Corrupt chunked memory image '%s'\n", filepath);
+
+    std::vector<ChunkEntry> table(header.numChunks);
+    fatal_if(!readAt(fd, table.data(), table.size() * sizeof(table[0]),
+                     sizeof(header)),
+             "Truncated chunked memory image '%s'\n", filepath);
+
+    const uint64_t page_size = pageSize;
+    std::atomic<bool> failed(false);
+    parallelFor(header.numChunks, checkpointThreads, [&](uint64_t chunk) {
+        const ChunkEntry &entry = table[chunk];
+        if (entry.size == 0)
+            return;
+
+        const uint64_t start = chunk * header.chunkSize;
+        const uint64_t size =
+            std::min(header.chunkSize, header.rangeSize - start);
+        std::vector<uint8_t> compressed(entry.size);
+        std::vector<uint8_t> data(size);
+        if (!readAt(fd, compressed.data(), entry.size, entry.offset) ||
+            !decompressChunk(header.codec, compressed.data(), entry.size,
+                             data.data(), size)) {
+            failed = true;
+            return;
+        }
+
+        // Only copy pages that are non-zero, so we don't give the VM
+        // system hell
+        for (uint64_t off = 0; off < size; off += page_size) {
+            const uint64_t len = std::min(page_size, size - off);
+            if (!isZero(data.data() + off, len))
+                memcpy(pmem + start + off, data.data() + off, len);
+        }
+    });
+
+    close(fd);
+    fatal_if(failed, "Failed to restore chunked memory image '%s'\n",
+             filepath);
+}
+
+void
+PhysicalMemory::serializeStorePages(const std::string &filepath,
+                                    unsigned int store_id,
+                                    AddrRange range, uint8_t* pmem) const
+{
+    const uint64_t page_size = pageSize;
+    const uint64_t range_size = range.size();
+    const uint64_t num_pages = divCeil(range_size, page_size);
+
+    const std::filesystem::path index_path =
+        std::filesystem::weakly_canonical(filepath);
+
+    // Use the last image of this store as the parent, provided it is
+    // still around and has the same layout
+    std::unique_ptr<PageImage> parent;
+    const std::string &last_path = lastPageImage[store_id];
+    if (!last_path.empty()) {
+        if (::access(last_path.c_str(), R_OK) == 0) {
+            parent.reset(new PageImage(last_path));
+            if (parent->pageSize() != page_size ||
+                parent->numPages() != num_pages) {
+                parent.reset();
+            }
+        }
+        warn_if(!parent, "Not using '%s' as parent of page image '%s'\n",
+                last_path, filepath);
+
+        // when checkpointing into the directory the memory was
+        // restored from, the image replaces its own parent
+        if (parent && parent->uses(index_path)) {
+            DPRINTF(Checkpoint, "Writing %s without a parent as it "
+                    "replaces one of its parents\n", filepath);
+            parent.reset();
+        }
+    }
+    const std::string parent_path = parent ?
+        std::filesystem::path(last_path).lexically_relative(
+            index_path.parent_path()).string() : "";
+
+    const std::string data_path = pageDataPath(filepath);
+    std::ofstream data(tempPath(data_path),
+                       std::ios::binary | std::ios::trunc);
+    fatal_if(!data, "Can't open physical memory checkpoint file '%s'\n",
+             tempPath(data_path));
+
+    std::vector<uint64_t> entries(num_pages);
+    // Source of every page in the data file, to verify hash matches
+    std::vector<const uint8_t *> data_pages;
+    std::unordered_multimap<uint64_t, uint64_t> page_hashes;
+
+    // The last page may be partial, pad it with zeros
+    std::vector<uint8_t> last_page(page_size, 0);
+    if (range_size % page_size) {
+        memcpy(last_page.data(), pmem + (num_pages - 1) * page_size,
+               range_size % page_size);
+    }
+
+    uint64_t parent_pages = 0;
+    uint64_t zero_pages = 0;
+    for (uint64_t page = 0; page < num_pages; ++page) {
+        const uint8_t *src = page * page_size + page_size <= range_size ?
+            pmem + page * page_size : last_page.data();
+
+        bool zero;
+        const uint64_t hash = hashPage(src, page_size, zero);
+        if (zero) {
+            entries[page] = ZeroPage;
+            ++zero_pages;
+            continue;
+        }
+
+        uint64_t data_page;
+        if (parent) {
+            const PageImage *image = parent->lookup(page, data_page);
+            if (image && memcmp(image->data(data_page), src,
+                                page_size) == 0) {
+                entries[page] = ParentPage;
+                ++parent_pages;
+                continue;
+            }
+        }
+
+        auto matches = page_hashes.equal_range(hash);
+        auto match = std::find_if(matches.first, matches.second,
+            [&](const std::pair<const uint64_t, uint64_t> &m) {
+                return memcmp(data_pages[m.second], src, page_size) == 0;
+            });
+        if (match != matches.second) {
+            entries[page] = FirstDataPage + match->second;
+            continue;
+        }
 
+        data_page = data_pages.size();
+        data_pages.push_back(src);
+        page_hashes.emplace(hash, data_page);
+        entries[page] = FirstDataPage + data_page;
+        data.write((const char *)src, page_size);
+    }
+
+    data.close();
+    fatal_if(data.fail(),
+             "Write failed on physical memory checkpoint file '%s'\n",
+             tempPath(data_path));
+    replaceFile(tempPath(data_path), data_path);
+
+    PageIndexHeader header;
+    memcpy(header.magic, PageIndexMagic, sizeof(PageIndexMagic));
+    header.version = PageIndexVersion;
+    header.pageSize = page_size;
+    header.numPages = num_pages;
+    header.numDataPages = data_pages.size();
+    header.parentLength = parent_path.size();
+
+    std::ofstream index(tempPath(filepath),
+                        std::ios::binary | std::ios::trunc);
+    fatal_if(!index, "Can't open physical memory checkpoint file '%s'\n",
+             tempPath(filepath));
+    index.write((const char *)&header, sizeof(header));
+    index.write(parent_path.data(), header.parentLength);
+    index.write((const char *)entries.data(),
+                entries.size() * sizeof(entries[0]));
+    index.close();
+    fatal_if(index.fail(),
+             "Write failed on physical memory checkpoint file '%s'\n",
+             tempPath(filepath));
+    replaceFile(tempPath(filepath), filepath);
+
+    DPRINTF(Checkpoint, "Wrote %d of %d pages (%d zero, %d in parent)\n",
+            data_pages.size(), num_pages, zero_pages, parent_pages);
+
+    // The next checkpoint of this store is relative to this one
+    lastPageImage[store_id] = index_path.string();
 }
 
 void
@@ -434,8 +1223,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -443,10 +1230,9 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
+    // checkpoints predating the format key are gzip compressed
+    std::string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
 
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
@@ -462,6 +1248,28 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    if (format == "gzip")
+        unserializeStoreGzip(filepath, pmem, range);
+    else if (format == "pages")
+        unserializeStorePages(filepath, store_id);
+    else if (format == "chunked")
+        unserializeStoreChunked(filepath, pmem, range);
+    else if (format == "raw")
+        unserializeStoreRaw(filepath, store_id);
+    else
+        fatal("Unknown physical memory checkpoint format '%s'\n", format);
+}
+
+void
+PhysicalMemory::unserializeStoreGzip(const std::string &filepath,
+                                     uint8_t* pmem, AddrRange range)
+{
+    const uint32_t chunk_size = 16384;
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -488,7 +1296,88 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeStorePages(const std::string &filepath,
+                                      unsigned int store_id)
+{
+    const BackingStoreEntry &store = backingStore[store_id];
+    const uint64_t range_size = store.range.size();
+
+    PageImage image(filepath);
+    const uint64_t page_size = image.pageSize();
+    fatal_if(image.numPages() != divCeil(range_size, page_size),
+             "Page image '%s' does not match the memory size\n", filepath);
+
+    // Group the non-zero pages into runs that are contiguous both in
+    // memory and in a data file
+    struct Run
+    {
+        const PageImage *image;
+        uint64_t page;
+        uint64_t dataPage;
+        uint64_t count;
+    };
+    std::vector<Run> runs;
+    for (uint64_t page = 0; page < image.numPages(); ++page) {
+        uint64_t data_page;
+        const PageImage *src = image.lookup(page, data_page);
+        if (!src)
+            continue;
+
+        if (!runs.empty()) {
+            Run &run = runs.back();
+            if (run.image == src && run.page + run.count == page &&
+                run.dataPage + run.count == data_page) {
+                ++run.count;
+                continue;
+            }
+        }
+        runs.push_back(Run{src, page, data_page, 1});
+    }
+
+    // Pages can only be mapped into a private backing store that
+    // uses the same page size as the image. Too many runs would
+    // exhaust the number of mappings of the process.
+    const bool map = store.shmFd == -1 && page_size == (uint64_t)pageSize &&
+        runs.size() <= MaxMappedRuns;
+    const uint64_t full_pages = range_size / page_size;
+
+    DPRINTF(Checkpoint, "Restoring %d runs of pages from %s by %s\n",
+            runs.size(), filepath, map ? "mapping" : "copying");
+
+    for (const auto &run : runs) {
+        uint8_t *dst = store.pmem + run.page * page_size;
+
+        // a partial page at the end of the store is always copied
+        uint64_t mapped = 0;
+        if (map) {
+            mapped = std::min(run.count, full_pages - run.page);
+            if (mapped) {
+                void *addr = mmap(dst, mapped * page_size,
+                                  PROT_READ | PROT_WRITE, restoreMapFlags(),
+                                  run.image->dataFd(),
+                                  run.dataPage * page_size);
+                if (addr == MAP_FAILED) {
+                    perror("mmap");
+                    fatal("Could not map page image '%s'\n", filepath);
+                }
+            }
+        }
+
+        const uint64_t offset = (run.page + mapped) * page_size;
+        const uint64_t bytes = std::min((run.count - mapped) * page_size,
+                                        range_size - std::min(range_size,
+                                                              offset));
+        memcpy(dst + mapped * page_size, run.image->data(run.dataPage +
+                                                          mapped), bytes);
+    }
+
+    // Checkpoints taken from here on only store the pages that differ
+    lastPageImage[store_id] =
+        std::filesystem::weakly_canonical(filepath).string();
 }
 
 } // namespace memory
@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -162,6 +163,19 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // Format used when writing the backing store to a checkpoint
+    const MemoryCheckpointFormat checkpointFormat;
+
+    // Host threads used for chunked memory images, 0 for all cores
+    const unsigned checkpointThreads;
+
+    /**
+     * Canonical path of the page index of the most recent page image
+     * written or restored for each backing store. Used as the parent of
+     * the next page image so that unchanged pages are not written again.
+     */
+    mutable std::vector<std::string> lastPageImage;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +205,10 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   MemoryCheckpointFormat checkpoint_format=
+                       MemoryCheckpointFormat::gzip,
+                   unsigned checkpoint_threads=0);
 
     /**
      * Unmap all the backing store we have used.
@@ -296,6 +313,58 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+  private:
+    /**
+     * Write a backing store as a single gzip compressed image.
+     */
+    void serializeStoreGzip(const std::string &filepath,
+                            AddrRange range, uint8_t* pmem) const;
+    void unserializeStoreGzip(const std::string &filepath,
+                              uint8_t* pmem, AddrRange range);
+
+    /**
+     * Write a backing store as independently compressed chunks. The
+     * chunks are compressed, and decompressed when restoring, on
+     * multiple host threads.
+     */
+    void serializeStoreChunked(const std::string &filepath,
+                               AddrRange range, uint8_t* pmem) const;
+    void unserializeStoreChunked(const std::string &filepath,
+                                 uint8_t* pmem, AddrRange range);
+
+    /**
+     * Flags used to map a memory image over a private backing store,
+     * which honour the same reservation policy as the backing store.
+     */
+    int restoreMapFlags() const;
+
+    /**
+     * Write a backing store as an uncompressed, sparse image. Restoring
+     * maps the image copy-on-write over the backing store.
+     */
+    void serializeStoreRaw(const std::string &filepath,
+                           AddrRange range, uint8_t* pmem) const;
+    void unserializeStoreRaw(const std::string &filepath,
+                             unsigned int store_id);
+
+    /**
+     * Write a backing store as a page image. Pages are stored
+     * uncompressed in a data file, zero pages are elided, identical
+     * pages are only stored once, and pages that are unchanged since
+     * the previous page image of this store refer to that image.
+     */
+    void serializeStorePages(const std::string &filepath,
+                             unsigned int store_id,
+                             AddrRange range, uint8_t* pmem) const;
+
+    /**
+     * Restore a page image. Runs of pages are mapped copy-on-write
+     * from the data files when possible so that they are only read
+     * when the simulated system touches them.
+     */
+    void unserializeStorePages(const std::string &filepath,
+                               unsigned int store_id);
+
 };
 
 } // namespace memory
@@ -55,23 +55,69 @@ Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    auto lock = parallelLock();
+    addWakeupTick(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
-        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
+    const Tick when =
+        divCeil(evt_time, em->clockPeriod()) * em->clockPeriod();
+
+    if (inParallelMode && curEventQueue() != em->eventQueue()) {
+        scheduleRemoteWakeup(when);
+        return;
+    }
+
+    auto lock = parallelLock();
+    addWakeupTick(when);
     scheduleNextWakeup();
 }
 
+bool
+Consumer::addWakeupTick(Tick when)
+{
+    if (m_wakeup_ticks.empty() || m_wakeup_ticks.back() < when) {
+        m_wakeup_ticks.push_back(when);
+        return true;
+    }
+
+    auto it = std::lower_bound(m_wakeup_ticks.begin(), m_wakeup_ticks.end(),
+                               when);
+    if (*it == when)
+        return false;
+    m_wakeup_ticks.insert(it, when);
+    return true;
+}
+
+void
+Consumer::scheduleRemoteWakeup(Tick when)
+{
+    // The wakeup event may only be scheduled by the thread of its own
+    // event queue. Post an event to that queue instead, which schedules
+    // the wakeup when it gets there. Ticks that are already pending will
+    // be reached by the wakeup event anyway.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!addWakeupTick(when))
+            return;
+    }
+
+    auto *event = new EventFunctionWrapper([this]{
+            auto lock = parallelLock();
+            scheduleNextWakeup();
+        }, "Consumer Remote Event", true, m_wakeup_event.priority());
+    em->eventQueue()->schedule(event, when);
+}
+
 void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
+    auto it = std::lower_bound(m_wakeup_ticks.begin(), m_wakeup_ticks.end(),
+                               em->clockEdge());
     if (it != m_wakeup_ticks.end()) {
         Tick when = *it;
         assert(when >= em->clockEdge());
@@ -85,13 +131,16 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
-
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
-    m_wakeup_ticks.erase(curr);
+    {
+        auto lock = parallelLock();
+        assert(em->clockEdge() == m_wakeup_ticks.front());
+        m_wakeup_ticks.pop_front();
+    }
     wakeup();
+
+    auto lock = parallelLock();
     scheduleNextWakeup();
 }
 
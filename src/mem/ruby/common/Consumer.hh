@@ -47,8 +47,13 @@
 #ifndef __MEM_RUBY_COMMON_CONSUMER_HH__
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
 #include <iostream>
-#include <set>
+#include <mutex>
 
 #include "sim/clocked_object.hh"
 
@@ -75,7 +80,41 @@ class Consumer
     bool
     alreadyScheduled(Tick time)
     {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
+        auto lock = parallelLock();
+        return std::binary_search(m_wakeup_ticks.begin(),
+                                  m_wakeup_ticks.end(), time);
+    }
+
+    /** Number of input ports that can be tracked by portPending(). */
+    static constexpr int MaxPendingPorts = 64;
+
+    /**
+     * Record whether the message buffer connected to an input port holds
+     * any messages, so that wakeup() can skip idle ports.
+     */
+    void
+    setPortPending(int port, bool pending)
+    {
+        assert(port >= 0 && port < MaxPendingPorts);
+        const uint64_t bit = (uint64_t)1 << port;
+        if (inParallelMode) {
+            // Buffers may be filled by other event queues
+            if (pending)
+                m_pending_ports.fetch_or(bit, std::memory_order_relaxed);
+            else
+                m_pending_ports.fetch_and(~bit, std::memory_order_relaxed);
+        } else {
+            uint64_t ports = m_pending_ports.load(std::memory_order_relaxed);
+            ports = pending ? ports | bit : ports & ~bit;
+            m_pending_ports.store(ports, std::memory_order_relaxed);
+        }
+    }
+
+    bool
+    portPending(int port) const
+    {
+        return m_pending_ports.load(std::memory_order_relaxed) &
+            ((uint64_t)1 << port);
     }
 
     ClockedObject *
@@ -84,14 +123,38 @@ class Consumer
         return em;
     }
 
+    /**
+     * Schedule a wakeup at an absolute time. In parallel mode, this may
+     * be called by objects on other event queues, as long as the time is
+     * at least one simulation quantum away.
+     */
     void scheduleEventAbsolute(Tick timeAbs);
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    /**
+     * Sorted wakeup ticks without duplicates. Wakeups are almost always
+     * added in order, so this is cheaper than a tree.
+     */
+    std::deque<Tick> m_wakeup_ticks;
+    std::atomic<uint64_t> m_pending_ports{0};
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
+    /** Protects the wakeup ticks in parallel mode. */
+    std::mutex m_mutex;
+
+    std::unique_lock<std::mutex>
+    parallelLock()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        if (inParallelMode)
+            lock.lock();
+        return lock;
+    }
+
+    bool addWakeupTick(Tick when);
+    void scheduleRemoteWakeup(Tick when);
     void scheduleNextWakeup();
     void processCurrentEvent();
 };
@@ -51,17 +51,16 @@ namespace ruby
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    alloc();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    const int size = RubySystem::getBlockSizeBytes();
+    m_alloc = size > InlineBytes;
+    m_data = m_alloc ? new uint8_t[size] : m_inline;
 }
 
 void
@@ -63,6 +63,7 @@ class DataBlock
     DataBlock()
     {
         alloc();
+        clear();
     }
 
     DataBlock(const DataBlock &cp);
@@ -91,9 +92,18 @@ class DataBlock
     void print(std::ostream& out) const;
 
   private:
+    /**
+     * Blocks of up to this many bytes are stored in the DataBlock itself
+     * rather than in a separate heap allocation, so that creating and
+     * copying messages and cache entries doesn't touch the heap.
+     */
+    static constexpr int InlineBytes = RUBY_INLINE_BLOCK_BYTES;
+
     void alloc();
     uint8_t *m_data;
+    /** Whether m_data was allocated on the heap by this block. */
     bool m_alloc;
+    uint8_t m_inline[InlineBytes];
 };
 
 inline void
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_LINEREQUESTTABLE_HH__
+#define __MEM_RUBY_COMMON_LINEREQUESTTABLE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A table of the outstanding requests of a sequencer, with a FIFO list
+ * of requests for each cache line.
+ *
+ * Lines are found through an open addressing hash table with linear
+ * probing. The lists and their requests are taken from pools that are
+ * allocated up front for the expected number of outstanding requests,
+ * so inserting and removing requests does not allocate memory. The
+ * pools grow in chunks if more requests are outstanding, and the hash
+ * table is resized if it becomes more than half full.
+ *
+ * Lists and requests never move, so references to them stay valid
+ * while other lines are added or removed, e.g., by callbacks that issue
+ * new requests while a list is being processed.
+ *
+ * @tparam T The request type.
+ */
+template <typename T>
+class LineRequestTable
+{
+  private:
+    struct Node
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Node *next;
+
+        T &value() { return *std::launder(reinterpret_cast<T *>(storage)); }
+    };
+
+  public:
+    /** The requests to a single line, oldest first. */
+    class List
+    {
+      public:
+        template <typename V, typename N>
+        class Iterator
+        {
+          public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef std::remove_const_t<V> value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef V *pointer;
+            typedef V &reference;
+
+            explicit Iterator(N *node) : node(node) {}
+            V &operator*() const { return node->value(); }
+            V *operator->() const { return &node->value(); }
+            Iterator &operator++() { node = node->next; return *this; }
+            bool operator==(const Iterator &o) const { return node == o.node; }
+            bool operator!=(const Iterator &o) const { return node != o.node; }
+
+          private:
+            N *node;
+        };
+
+        typedef Iterator<T, Node> iterator;
+        typedef Iterator<const T, Node> const_iterator;
+
+        Addr address() const { return addr; }
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+
+        T &front() { assert(head); return head->value(); }
+        const T &front() const { assert(head); return head->value(); }
+
+        template <typename... Args>
+        T &
+        emplace_back(Args&&... args)
+        {
+            Node *node = table->allocNode();
+            new (node->storage) T(std::forward<Args>(args)...);
+            node->next = nullptr;
+            if (tail)
+                tail->next = node;
+            else
+                head = node;
+            tail = node;
+            ++_size;
+            return node->value();
+        }
+
+        void
+        pop_front()
+        {
+            assert(head);
+            Node *node = head;
+            head = node->next;
+            if (!head)
+                tail = nullptr;
+            --_size;
+            node->value().~T();
+            table->freeNode(node);
+        }
+
+        iterator begin() { return iterator(head); }
+        iterator end() { return iterator(nullptr); }
+        const_iterator begin() const { return const_iterator(head); }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+      private:
+        friend class LineRequestTable;
+
+        void
+        clear()
+        {
+            while (!empty())
+                pop_front();
+        }
+
+        LineRequestTable *table = nullptr;
+        Addr addr = 0;
+        Node *head = nullptr;
+        Node *tail = nullptr;
+        size_t _size = 0;
+        /** Next free list in the pool. */
+        List *nextFree = nullptr;
+    };
+
+  private:
+    struct Slot
+    {
+        Addr addr;
+        List *list;
+    };
+
+  public:
+    /**
+     * @param capacity The number of requests, and lines, the table is
+     *        expected to hold at the same time.
+     */
+    explicit LineRequestTable(size_t capacity)
+        : chunkSize(std::max<size_t>(capacity, MinChunkSize))
+    {
+        slots.resize(size_t(1) << ceilLog2(2 * chunkSize), Slot{0, nullptr});
+        shift = 64 - floorLog2(slots.size());
+        growNodes();
+        growLists();
+    }
+
+    ~LineRequestTable()
+    {
+        for (auto &slot : slots) {
+            if (slot.list)
+                slot.list->clear();
+        }
+    }
+
+    LineRequestTable(const LineRequestTable &) = delete;
+    LineRequestTable &operator=(const LineRequestTable &) = delete;
+
+    /** Number of lines with outstanding requests. */
+    size_t size() const { return numLines; }
+    bool empty() const { return numLines == 0; }
+    size_t count(Addr addr) const { return find(addr) ? 1 : 0; }
+
+    /** The list of a line, or nullptr if it has none. */
+    List *
+    find(Addr addr) const
+    {
+        for (size_t i = index(addr); ; i = (i + 1) & mask()) {
+            if (!slots[i].list)
+                return nullptr;
+            if (slots[i].addr == addr)
+                return slots[i].list;
+        }
+    }
+
+    /** The list of a line, which must exist. */
+    List &
+    at(Addr addr) const
+    {
+        List *list = find(addr);
+        assert(list);
+        return *list;
+    }
+
+    /** The list of a line, which is added if it does not exist. */
+    List &
+    operator[](Addr addr)
+    {
+        size_t i = index(addr);
+        for (; slots[i].list; i = (i + 1) & mask()) {
+            if (slots[i].addr == addr)
+                return *slots[i].list;
+        }
+
+        if (2 * (numLines + 1) > slots.size()) {
+            rehash(2 * slots.size());
+            return (*this)[addr];
+        }
+
+        List *list = allocList();
+        list->table = this;
+        list->addr = addr;
+        slots[i] = Slot{addr, list};
+        ++numLines;
+        return *list;
+    }
+
+    /** Remove a line and all its requests. */
+    void
+    erase(Addr addr)
+    {
+        size_t i = index(addr);
+        while (slots[i].list && slots[i].addr != addr)
+            i = (i + 1) & mask();
+        if (!slots[i].list)
+            return;
+
+        List *list = slots[i].list;
+        list->clear();
+        freeList(list);
+        --numLines;
+
+        // Move entries back into the hole so that lookups, which stop at
+        // the first empty slot, still find them.
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask(); slots[j].list;
+             j = (j + 1) & mask()) {
+            const size_t home = index(slots[j].addr);
+            if (((j - home) & mask()) >= ((j - hole) & mask())) {
+                slots[hole] = slots[j];
+                hole = j;
+            }
+        }
+        slots[hole] = Slot{0, nullptr};
+    }
+
+    /** Iteration over the lists of all lines, in no particular order. */
+    template <typename V, typename S>
+    class Iterator
+    {
+      public:
+        Iterator(S *slot, S *end) : slot(slot), last(end) { skip(); }
+        V &operator*() const { return *slot->list; }
+        V *operator->() const { return slot->list; }
+        Iterator &operator++() { ++slot; skip(); return *this; }
+        bool operator==(const Iterator &o) const { return slot == o.slot; }
+        bool operator!=(const Iterator &o) const { return slot != o.slot; }
+
+      private:
+        void skip() { while (slot != last && !slot->list) ++slot; }
+
+        S *slot;
+        S *last;
+    };
+
+    typedef Iterator<List, Slot> iterator;
+    typedef Iterator<const List, const Slot> const_iterator;
+
+    iterator
+    begin()
+    {
+        return iterator(slots.data(), slots.data() + slots.size());
+    }
+
+    iterator
+    end()
+    {
+        Slot *last = slots.data() + slots.size();
+        return iterator(last, last);
+    }
+
+    const_iterator
+    begin() const
+    {
+        return const_iterator(slots.data(), slots.data() + slots.size());
+    }
+
+    const_iterator
+    end() const
+    {
+        const Slot *last = slots.data() + slots.size();
+        return const_iterator(last, last);
+    }
+
+  private:
+    static constexpr size_t MinChunkSize = 16;
+
+    size_t mask() const { return slots.size() - 1; }
+
+    /** Fibonacci hashing, which spreads line addresses over the table. */
+    size_t
+    index(Addr addr) const
+    {
+        return (uint64_t(addr) * 0x9E3779B97F4A7C15ULL) >> shift;
+    }
+
+    void
+    rehash(size_t new_size)
+    {
+        std::vector<Slot> old(new_size, Slot{0, nullptr});
+        old.swap(slots);
+        shift = 64 - floorLog2(slots.size());
+        for (const auto &slot : old) {
+            if (!slot.list)
+                continue;
+            size_t i = index(slot.addr);
+            while (slots[i].list)
+                i = (i + 1) & mask();
+            slots[i] = slot;
+        }
+    }
+
+    Node *
+    allocNode()
+    {
+        if (!freeNodes)
+            growNodes();
+        Node *node = freeNodes;
+        freeNodes = node->next;
+        return node;
+    }
+
+    void
+    freeNode(Node *node)
+    {
+        node->next = freeNodes;
+        freeNodes = node;
+    }
+
+    void
+    growNodes()
+    {
+        nodeChunks.emplace_back(new Node[chunkSize]);
+        Node *chunk = nodeChunks.back().get();
+        for (size_t i = 0; i < chunkSize; i++)
+            freeNode(&chunk[i]);
+    }
+
+    List *
+    allocList()
+    {
+        if (!freeLists)
+            growLists();
+        List *list = freeLists;
+        freeLists = list->nextFree;
+        return list;
+    }
+
+    void
+    freeList(List *list)
+    {
+        list->nextFree = freeLists;
+        freeLists = list;
+    }
+
+    void
+    growLists()
+    {
+        listChunks.emplace_back(new List[chunkSize]);
+        List *chunk = listChunks.back().get();
+        for (size_t i = 0; i < chunkSize; i++)
+            freeList(&chunk[i]);
+    }
+
+    const size_t chunkSize;
+
+    std::vector<Slot> slots;
+    int shift;
+    size_t numLines = 0;
+
+    std::vector<std::unique_ptr<Node[]>> nodeChunks;
+    Node *freeNodes = nullptr;
+    std::vector<std::unique_ptr<List[]>> listChunks;
+    List *freeLists = nullptr;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_LINEREQUESTTABLE_HH__
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include "mem/ruby/common/LineRequestTable.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** Counts its live instances to check that the table destroys them. */
+struct Request
+{
+    static int live;
+
+    int id;
+
+    Request(int id) : id(id) { live++; }
+    Request(const Request &other) : id(other.id) { live++; }
+    ~Request() { live--; }
+};
+
+int Request::live = 0;
+
+} // anonymous namespace
+
+TEST(LineRequestTableTest, Fifo)
+{
+    LineRequestTable<Request> table(4);
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table.find(0x40), nullptr);
+
+    table[0x40].emplace_back(1);
+    table[0x80].emplace_back(2);
+    table[0x40].emplace_back(3);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.count(0x40), 1u);
+    EXPECT_EQ(table.at(0x40).address(), Addr(0x40));
+
+    auto &list = table.at(0x40);
+    ASSERT_EQ(list.size(), 2u);
+    EXPECT_EQ(list.front().id, 1);
+    list.pop_front();
+    EXPECT_EQ(list.front().id, 3);
+    list.pop_front();
+    EXPECT_TRUE(list.empty());
+
+    table.erase(0x40);
+    EXPECT_EQ(table.find(0x40), nullptr);
+    EXPECT_EQ(table.at(0x80).front().id, 2);
+
+    table.erase(0x80);
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(Request::live, 0);
+}
+
+/** Lists stay in place when other lines are added and removed. */
+TEST(LineRequestTableTest, StableReferences)
+{
+    LineRequestTable<Request> table(2);
+    auto &list = table[0x1000];
+    Request &first = list.emplace_back(0);
+
+    // Grow the pools and the hash table well beyond their initial size
+    for (int i = 1; i < 1000; i++)
+        table[0x1000 + i * 0x40].emplace_back(i);
+    for (int i = 1; i < 1000; i += 2)
+        table.erase(0x1000 + i * 0x40);
+
+    EXPECT_EQ(&table.at(0x1000), &list);
+    EXPECT_EQ(&list.front(), &first);
+    EXPECT_EQ(table.size(), 500u);
+}
+
+/** Random operations give the same results as node-based containers. */
+TEST(LineRequestTableTest, Random)
+{
+    std::mt19937 rng(42);
+    std::unordered_map<Addr, std::list<int>> reference;
+    {
+        LineRequestTable<Request> table(16);
+        int next_id = 0;
+        for (int i = 0; i < 100000; i++) {
+            // Few lines so that they collide and alias often
+            const Addr addr = (rng() % 64) * 0x40;
+            const int op = rng() % 4;
+            if (op < 2) {
+                table[addr].emplace_back(next_id);
+                reference[addr].push_back(next_id++);
+            } else if (op == 2) {
+                auto *list = table.find(addr);
+                ASSERT_EQ(list != nullptr, reference.count(addr) == 1);
+                if (list) {
+                    ASSERT_EQ(list->front().id, reference[addr].front());
+                    list->pop_front();
+                    reference[addr].pop_front();
+                    if (list->empty()) {
+                        table.erase(addr);
+                        reference.erase(addr);
+                    }
+                }
+            } else if (rng() % 8 == 0) {
+                table.erase(addr);
+                reference.erase(addr);
+            }
+        }
+
+        ASSERT_EQ(table.size(), reference.size());
+        size_t lines = 0;
+        for (const auto &list : table) {
+            const auto &expected = reference.at(list.address());
+            ASSERT_EQ(list.size(), expected.size());
+            auto it = expected.begin();
+            for (const auto &request : list)
+                EXPECT_EQ(request.id, *it++);
+            lines++;
+        }
+        EXPECT_EQ(lines, reference.size());
+    }
+    EXPECT_EQ(Request::live, 0);
+}
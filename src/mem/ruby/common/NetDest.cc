@@ -30,30 +30,20 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
 namespace gem5
 {
 
 namespace ruby
 {
 
-NetDest::NetDest()
-{
-  resize();
-}
-
-void
-NetDest::add(MachineID newElement)
-{
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
-}
-
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -63,29 +53,18 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
-}
-
-void
-NetDest::remove(MachineID oldElement)
-{
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
-}
-
-void
-NetDest::removeNetDest(const NetDest& netDest)
-{
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    std::fill_n(&m_bits[machine * WordsPerType], WordsPerType, 0);
+    for (NodeID j = 0; j < set.getSize(); j++) {
+        if (set.isElement(j))
+            add({machine, j});
     }
 }
 
 void
-NetDest::clear()
+NetDest::removeNetDest(const NetDest& netDest)
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
@@ -101,9 +80,11 @@ NetDest::broadcast()
 void
 NetDest::broadcast(MachineType machineType)
 {
-    for (NodeID i = 0; i < MachineType_base_count(machineType); i++) {
-        MachineID mach = {machineType, i};
-        add(mach);
+    int remaining = MachineType_base_count(machineType);
+    assert(remaining <= NUMBER_BITS_PER_SET);
+    for (int i = machineType * WordsPerType; remaining > 0; i++) {
+        m_bits[i] |= mask(std::min(remaining, WordBits));
+        remaining -= WordBits;
     }
 }
 
@@ -112,13 +93,17 @@ std::vector<NodeID>
 NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
-            }
+    for (int i = 0; i < NumWords; i++) {
+        uint64_t word = m_bits[i];
+        if (!word)
+            continue;
+
+        const MachineType machine = MachineType(i / WordsPerType);
+        const NodeID base = MachineType_base_number(machine) +
+            (i % WordsPerType) * WordBits;
+        while (word) {
+            dest.push_back(base + ctz64(word));
+            word &= word - 1;
         }
     }
     return dest;
@@ -128,28 +113,21 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < NumWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
 
-NodeID
-NetDest::elementAt(MachineID index)
-{
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
-}
-
 MachineID
 NetDest::smallestElement() const
 {
-    assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
+            MachineID mach = {MachineType(i / WordsPerType),
+                              NodeID((i % WordsPerType) * WordBits +
+                                     ctz64(m_bits[i]))};
+            return mach;
         }
     }
     panic("No smallest element of an empty set.");
@@ -158,10 +136,10 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
+    for (int i = 0; i < WordsPerType; i++) {
+        const uint64_t word = m_bits[machine * WordsPerType + i];
+        if (word) {
+            MachineID mach = {machine, NodeID(i * WordBits + ctz64(word))};
             return mach;
         }
     }
@@ -173,8 +151,12 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        int count = 0;
+        for (int i = 0; i < WordsPerType; i++)
+            count += popCount(m_bits[machine * WordsPerType + i]);
+        if (count != MachineType_base_count(machine)) {
             return false;
         }
     }
@@ -185,22 +167,20 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
-            return false;
-        }
+    uint64_t any = 0;
+    for (int i = 0; i < NumWords; i++) {
+        any |= m_bits[i];
     }
-    return true;
+    return !any;
 }
 
 // returns the logical OR of "this" set and orNetDest
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -209,10 +189,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -221,69 +200,37 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
+    uint64_t any = 0;
+    for (int i = 0; i < NumWords; i++) {
+        any |= m_bits[i] & other_netDest.m_bits[i];
     }
-    return false;
+    return any;
 }
 
 bool
 NetDest::isSuperset(const NetDest& test) const
 {
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool
-NetDest::isElement(MachineID element) const
-{
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
-}
-
-void
-NetDest::resize()
-{
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
+    uint64_t missing = 0;
+    for (int i = 0; i < NumWords; i++) {
+        missing |= test.m_bits[i] & ~m_bits[i];
     }
+    return !missing;
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << getSize() << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (MachineType machine = MachineType_FIRST;
+         machine < MachineType_NUM; ++machine) {
+        for (NodeID j = 0; j < MachineType_base_count(machine); j++) {
+            out << isElement({machine, j}) << " ";
         }
         out << " - ";
     }
     out << "]";
 }
 
-bool
-NetDest::isEqual(const NetDest& n) const
-{
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
-}
-
 } // namespace ruby
 } // namespace gem5
@@ -29,6 +29,8 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -42,12 +44,18 @@ namespace ruby
 {
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations are kept in a single fixed-size bit vector with
+// NUMBER_BITS_PER_SET bits, rounded up to whole words, for every
+// machine type. This keeps a NetDest free of heap allocations, so that
+// copying one only copies a few words, and turns set operations into
+// loops over a constant number of words.
 class NetDest
 {
   public:
     // Constructors
     // creates and empty set
-    NetDest();
+    NetDest() : m_bits{} {}
     explicit NetDest(int bit_size);
 
     NetDest& operator=(const Set& obj);
@@ -55,16 +63,33 @@ class NetDest
     ~NetDest()
     { }
 
-    void add(MachineID newElement);
+    void
+    add(MachineID newElement)
+    {
+        assert(newElement.num < MachineType_base_count(newElement.type));
+        m_bits[wordIndex(newElement)] |= bitMask(newElement);
+    }
+
     void addNetDest(const NetDest& netDest);
     void setNetDest(MachineType machine, const Set& set);
-    void remove(MachineID oldElement);
+
+    void
+    remove(MachineID oldElement)
+    {
+        m_bits[wordIndex(oldElement)] &= ~bitMask(oldElement);
+    }
+
     void removeNetDest(const NetDest& netDest);
-    void clear();
+    void clear() { m_bits.fill(0); }
     void broadcast();
     void broadcast(MachineType machine);
     int count() const;
-    bool isEqual(const NetDest& netDest) const;
+
+    bool
+    isEqual(const NetDest& netDest) const
+    {
+        return m_bits == netDest.m_bits;
+    }
 
     // return the logical OR of this netDest and orNetDest
     NetDest OR(const NetDest& orNetDest) const;
@@ -76,11 +101,21 @@ class NetDest
     bool intersectionIsNotEmpty(const NetDest& other_netDest) const;
 
     // Returns true if the intersection of the two netDests is empty
-    bool intersectionIsEmpty(const NetDest& other_netDest) const;
+    bool
+    intersectionIsEmpty(const NetDest& other_netDest) const
+    {
+        return !intersectionIsNotEmpty(other_netDest);
+    }
 
     bool isSuperset(const NetDest& test) const;
     bool isSubset(const NetDest& test) const { return test.isSuperset(*this); }
-    bool isElement(MachineID element) const;
+
+    bool
+    isElement(MachineID element) const
+    {
+        return m_bits[wordIndex(element)] & bitMask(element);
+    }
+
     bool isBroadcast() const;
     bool isEmpty() const;
 
@@ -90,28 +125,38 @@ class NetDest
     MachineID smallestElement() const;
     MachineID smallestElement(MachineType machine) const;
 
-    void resize();
-    int getSize() const { return m_bits.size(); }
+    // Kept for compatibility, the size of a NetDest is fixed. Like
+    // before, this removes all destinations.
+    void resize() { clear(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
-    NodeID elementAt(MachineID index);
+    NodeID elementAt(MachineID index) { return isElement(index); }
 
     void print(std::ostream& out) const;
 
   private:
-    // returns a value >= MachineType_base_level("this machine")
-    // and < MachineType_base_level("next highest machine")
-    int
-    vecIndex(MachineID m) const
+    static constexpr int WordBits = 64;
+    static constexpr int WordsPerType =
+        (NUMBER_BITS_PER_SET + WordBits - 1) / WordBits;
+    static constexpr int NumWords = WordsPerType * MachineType_NUM;
+
+    // The words of a machine type start at its base level, which is the
+    // position of the type in MachineType
+    static int
+    wordIndex(MachineID m)
     {
-        int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
-        return vec_index;
+        assert(m.type < MachineType_NUM && m.num < NUMBER_BITS_PER_SET);
+        return m.type * WordsPerType + m.num / WordBits;
     }
 
-    NodeID bitIndex(NodeID index) const { return index; }
+    static uint64_t
+    bitMask(MachineID m)
+    {
+        return uint64_t(1) << (m.num % WordBits);
+    }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    std::array<uint64_t, NumWords> m_bits;
 };
 
 inline std::ostream&
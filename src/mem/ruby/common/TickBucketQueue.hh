@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_TICKBUCKETQUEUE_HH__
+#define __MEM_RUBY_COMMON_TICKBUCKETQUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A priority queue of items ordered by the tick they become ready and,
+ * for items ready at the same tick, by a sequence number.
+ *
+ * Items ready at the same tick are kept in a FIFO bucket, and buckets
+ * are kept sorted by tick. Most items are enqueued with a constant
+ * delay, so they go to the back of the last bucket and are popped from
+ * the front of the first one without any comparisons between items.
+ * Items that are ready earlier than the last bucket, or whose sequence
+ * number is older than the last item of their bucket, are inserted in
+ * order using a binary search.
+ *
+ * @tparam T The item type, which only has to be movable.
+ * @tparam Keys Provides the ready tick and the sequence number of an
+ *         item as static Tick time(const T &) and
+ *         uint64_t order(const T &).
+ */
+template <typename T, typename Keys>
+class TickBucketQueue
+{
+  public:
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    /** The first item. The queue must not be empty. */
+    const T &
+    front() const
+    {
+        assert(!empty());
+        const Bucket &bucket = buckets.front();
+        return bucket.items[bucket.head];
+    }
+
+    void
+    push(T item)
+    {
+        const Tick tick = Keys::time(item);
+
+        Bucket *bucket;
+        if (!buckets.empty() && buckets.back().tick == tick) {
+            bucket = &buckets.back();
+        } else if (buckets.empty() || buckets.back().tick < tick) {
+            bucket = &newBucket(buckets.end(), tick);
+        } else {
+            auto it = std::lower_bound(buckets.begin(), buckets.end(), tick,
+                [](const Bucket &b, Tick t) { return b.tick < t; });
+            bucket = it->tick == tick ? &*it : &newBucket(it, tick);
+        }
+
+        auto &items = bucket->items;
+        const uint64_t order = Keys::order(item);
+        if (items.size() == bucket->head ||
+                Keys::order(items.back()) <= order) {
+            items.push_back(std::move(item));
+        } else {
+            auto pos = std::upper_bound(items.begin() + bucket->head,
+                items.end(), order,
+                [](uint64_t o, const T &i) { return o < Keys::order(i); });
+            items.insert(pos, std::move(item));
+        }
+        ++_size;
+    }
+
+    /** Remove and return the first item. */
+    T
+    pop()
+    {
+        assert(!empty());
+        Bucket &bucket = buckets.front();
+        T item = std::move(bucket.items[bucket.head++]);
+        if (bucket.head == bucket.items.size()) {
+            if (spare.size() < MaxSpare) {
+                bucket.items.clear();
+                spare.push_back(std::move(bucket.items));
+            }
+            buckets.pop_front();
+        }
+        --_size;
+        return item;
+    }
+
+    void
+    clear()
+    {
+        buckets.clear();
+        _size = 0;
+    }
+
+    /**
+     * Call f for every item, in order, until it returns true.
+     *
+     * @return Whether f returned true.
+     */
+    template <typename F>
+    bool
+    forEach(F &&f) const
+    {
+        for (const Bucket &bucket : buckets) {
+            for (auto it = bucket.items.begin() + bucket.head;
+                    it != bucket.items.end(); ++it) {
+                if (f(*it))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    struct Bucket
+    {
+        Tick tick;
+        /** Index of the first item that hasn't been popped. */
+        size_t head = 0;
+        std::vector<T> items;
+    };
+
+    /** Number of emptied bucket vectors kept for reuse. */
+    static constexpr size_t MaxSpare = 16;
+
+    Bucket &
+    newBucket(typename std::deque<Bucket>::iterator pos, Tick tick)
+    {
+        auto it = buckets.emplace(pos);
+        it->tick = tick;
+        if (!spare.empty()) {
+            it->items = std::move(spare.back());
+            spare.pop_back();
+        }
+        return *it;
+    }
+
+    /** Buckets sorted by tick, none of them empty. */
+    std::deque<Bucket> buckets;
+    std::vector<std::vector<T>> spare;
+    size_t _size = 0;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_TICKBUCKETQUEUE_HH__
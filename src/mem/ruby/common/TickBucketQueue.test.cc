@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/ruby/common/TickBucketQueue.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+struct Item
+{
+    Tick time;
+    uint64_t counter;
+};
+
+typedef std::shared_ptr<Item> ItemPtr;
+
+struct ItemOrder
+{
+    static Tick time(const ItemPtr &i) { return i->time; }
+    static uint64_t order(const ItemPtr &i) { return i->counter; }
+};
+
+/** The reference order, as previously used by MessageBuffer's heap. */
+bool
+operator>(const ItemPtr &a, const ItemPtr &b)
+{
+    return a->time > b->time ||
+        (a->time == b->time && a->counter > b->counter);
+}
+
+typedef TickBucketQueue<ItemPtr, ItemOrder> Queue;
+
+} // anonymous namespace
+
+TEST(TickBucketQueueTest, Empty)
+{
+    Queue queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+
+    queue.push(std::make_shared<Item>(Item{10, 0}));
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size(), 1);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+}
+
+/** Items are ordered by time first and by counter second. */
+TEST(TickBucketQueueTest, Order)
+{
+    Queue queue;
+    queue.push(std::make_shared<Item>(Item{20, 1}));
+    queue.push(std::make_shared<Item>(Item{10, 3}));
+    queue.push(std::make_shared<Item>(Item{20, 0}));
+    queue.push(std::make_shared<Item>(Item{10, 2}));
+    queue.push(std::make_shared<Item>(Item{15, 4}));
+
+    const std::vector<std::pair<Tick, uint64_t>> expected = {
+        {10, 2}, {10, 3}, {15, 4}, {20, 0}, {20, 1} };
+
+    std::vector<std::pair<Tick, uint64_t>> visited;
+    queue.forEach([&visited](const ItemPtr &i) {
+        visited.emplace_back(i->time, i->counter);
+        return false;
+    });
+    EXPECT_EQ(visited, expected);
+
+    for (const auto &e : expected) {
+        ASSERT_EQ(queue.front()->time, e.first);
+        ItemPtr item = queue.pop();
+        EXPECT_EQ(item->time, e.first);
+        EXPECT_EQ(item->counter, e.second);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/** forEach stops at the first item for which the function is true. */
+TEST(TickBucketQueueTest, ForEachStops)
+{
+    Queue queue;
+    for (uint64_t i = 0; i < 8; ++i)
+        queue.push(std::make_shared<Item>(Item{i / 2, i}));
+
+    int calls = 0;
+    EXPECT_TRUE(queue.forEach([&calls](const ItemPtr &i) {
+        ++calls;
+        return i->counter == 4;
+    }));
+    EXPECT_EQ(calls, 5);
+    EXPECT_FALSE(queue.forEach([](const ItemPtr &i) { return false; }));
+}
+
+/** Random pushes and pops pop items in the same order as a heap. */
+TEST(TickBucketQueueTest, MatchesHeap)
+{
+    std::mt19937 rng(0);
+    Queue queue;
+    std::vector<ItemPtr> heap;
+    uint64_t counter = 0;
+    Tick now = 0;
+
+    for (int op = 0; op < 100000; ++op) {
+        if (rng() % 3 != 0 || heap.empty()) {
+            // Mostly constant delays, some earlier items, like recycled
+            // or reanalyzed messages, and some older counters
+            Tick time = now + 1000;
+            uint64_t order = counter++;
+            switch (rng() % 8) {
+              case 0: time = now + rng() % 2000; break;
+              case 1: order = rng() % counter; break;
+              default: break;
+            }
+            auto item = std::make_shared<Item>(Item{time, order});
+            heap.push_back(item);
+            std::push_heap(heap.begin(), heap.end(),
+                           std::greater<ItemPtr>());
+            queue.push(item);
+        } else {
+            ItemPtr expected = heap.front();
+            std::pop_heap(heap.begin(), heap.end(), std::greater<ItemPtr>());
+            heap.pop_back();
+
+            ASSERT_EQ(queue.front()->time, expected->time);
+            ASSERT_EQ(queue.front()->counter, expected->counter);
+            queue.pop();
+            now = expected->time;
+        }
+        ASSERT_EQ(queue.size(), heap.size());
+    }
+}
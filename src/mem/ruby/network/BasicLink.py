@@ -36,12 +36,13 @@ class BasicLink(SimObject):
     link_id = Param.Int("ID in relation to other links")
     latency = Param.Cycles(1, "latency")
     # Width of the link in bytes
-    # Only used by simple network.
+    # Only used by simple and analytical networks.
     # Garnet models this by flit size
     # For the simple links, the bandwidth factor translates to the
     # bandwidth multiplier.  The multipiler, in combination with the
     # endpoint bandwidth multiplier - message size multiplier ratio,
-    # determines the link bandwidth in bytes
+    # determines the link bandwidth in bytes. The analytical network
+    # takes it as the bandwidth of the link in bytes per cycle.
     bandwidth_factor = Param.Int("generic bandwidth factor, usually in bytes")
     weight = Param.Int(1, "used to restrict routing in shortest path analysis")
     supported_vnets = VectorParam.Int([], "Vnets supported Default:All([])")
@@ -54,7 +55,7 @@ class BasicExtLink(BasicLink):
 
     ext_node = Param.RubyController("External node")
     int_node = Param.BasicRouter("ID of internal node")
-    bandwidth_factor = 16  # only used by simple network
+    bandwidth_factor = 16  # only used by simple and analytical networks
 
 
 class BasicIntLink(BasicLink):
@@ -69,5 +70,5 @@ class BasicIntLink(BasicLink):
     src_outport = Param.String("", "Outport direction at src router")
     dst_inport = Param.String("", "Inport direction at dst router")
 
-    # only used by simple network
+    # only used by simple and analytical networks
     bandwidth_factor = 16
@@ -86,6 +86,7 @@ MessageBuffer::MessageBuffer(const Params &p)
 {
     m_msg_counter = 0;
     m_consumer = NULL;
+    m_consumer_port = -1;
     m_size_last_time_size_checked = 0;
     m_size_at_cycle_start = 0;
     m_stalled_at_cycle_start = 0;
@@ -135,9 +136,10 @@ MessageBuffer::MessageBuffer(const Params &p)
 unsigned int
 MessageBuffer::getSize(Tick curTime)
 {
+    auto lock = parallelLock();
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = m_msg_queue.size();
     }
 
     return m_size_last_time_size_checked;
@@ -146,6 +148,7 @@ MessageBuffer::getSize(Tick curTime)
 bool
 MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 {
+    auto lock = parallelLock();
 
     // fast path when message buffers have infinite size
     if (m_max_size == 0) {
@@ -160,8 +163,8 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
     unsigned int current_stall_size = 0;
 
     if (m_time_last_time_pop < current_time) {
-        // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        // no pops this cycle - queue and stall map size is correct
+        current_size = m_msg_queue.size();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -181,10 +184,10 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
     if (current_size + current_stall_size + n <= m_max_size) {
         return true;
     } else {
-        DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
+        DPRINTF(RubyQueue, "n: %d, current_size: %d, queue size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                m_msg_queue.size(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -193,8 +196,9 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 const Message*
 MessageBuffer::peek() const
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = m_msg_queue.front().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -216,6 +220,7 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
+    auto lock = parallelLock();
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -252,6 +257,16 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 
     // Check the arrival time
     assert(arrival_time >= current_time);
+
+    // A message for a consumer on another event queue must not arrive
+    // before that queue may have moved on, i.e., before the end of the
+    // current quantum.
+    panic_if(inParallelMode &&
+             m_consumer->getObject()->eventQueue() != curEventQueue() &&
+             arrival_time - current_time < simQuantum,
+             "%s: Message crosses event queues with a latency of %d ticks, "
+             "below the simulation quantum of %d ticks.\n",
+             name(), arrival_time - current_time, simQuantum);
     if (m_strict_fifo) {
         if (arrival_time < m_last_arrival_time) {
             panic("FIFO ordering violated: %s name: %s current time: %d "
@@ -277,17 +292,17 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
+            arrival_time, *msg_ptr);
+
+    // Insert the message into the queue
+    m_msg_queue.push(std::move(message));
+    updatePortPending();
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
-
-    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
-            arrival_time, *(message.get()));
+           ((m_msg_queue.size() + m_stall_map_size) <= m_max_size));
 
     // Schedule the wakeup
     assert(m_consumer != NULL);
@@ -298,28 +313,35 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
+    MsgPtr message;
+    return dequeue(current_time, message, decrement_messages);
+}
+
+Tick
+MessageBuffer::dequeue(Tick current_time, MsgPtr &message,
+                       bool decrement_messages)
+{
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "Popping\n");
     assert(isReady(current_time));
 
-    // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
-
-    // get the delay cycles
-    message->updateDelayedTicks(current_time);
-    Tick delay = message->getDelayedTicks();
-
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = m_msg_queue.size();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
+    message = m_msg_queue.pop();
+    updatePortPending();
+
+    // get the delay cycles
+    message->updateDelayedTicks(current_time);
+    Tick delay = message->getDelayedTicks();
+
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -353,7 +375,9 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
-    m_prio_heap.clear();
+    auto lock = parallelLock();
+    m_msg_queue.clear();
+    updatePortPending();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -366,73 +390,73 @@ MessageBuffer::clear()
 void
 MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = m_msg_queue.pop();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    m_msg_queue.push(std::move(node));
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::reanalyzeList(StalledMsgList &lt, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
+    auto lock = parallelLock();
+    for (auto &m : lt) {
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
-
-        m_consumer->scheduleEventAbsolute(schdTick);
-
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
 
-        lt.pop_front();
+        m_msg_queue.push(std::move(m));
     }
+    updatePortPending();
+
+    if (!lt.empty())
+        m_consumer->scheduleEventAbsolute(schdTick);
+    lt.clear();
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
+    auto it = m_stall_msg_map.find(addr);
+    assert(it != m_stall_msg_map.end());
 
     //
-    // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // Put all stalled messages associated with this address back in the
+    // queue.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
+    m_stall_map_size -= it->second.size();
     assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    reanalyzeList(it->second, current_time);
+    m_stall_msg_map.erase(it);
 }
 
 void
 MessageBuffer::reanalyzeAllMessages(Tick current_time)
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "ReanalyzeAllMessages\n");
 
     //
-    // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
-    // scheduled for the current cycle so that the previously stalled messages
-    // will be observed before any younger messages that may arrive this cycle.
+    // Put all stalled messages back in the queue.  The reanalyzeList call
+    // will make sure the consumer is scheduled for the current cycle so that
+    // the previously stalled messages will be observed before any younger
+    // messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
+    for (auto &stalled : m_stall_msg_map) {
+        m_stall_map_size -= stalled.second.size();
         assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
+        reanalyzeList(stalled.second, current_time);
     }
     m_stall_msg_map.clear();
 }
@@ -440,21 +464,22 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 void
 MessageBuffer::stallMessage(Addr addr, Tick current_time)
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
-    dequeue(current_time, false);
+    MsgPtr message;
+    dequeue(current_time, message, false);
 
     //
     // Note: no event is scheduled to analyze the map at a later time.
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    m_stall_msg_map[addr].push_back(std::move(message));
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -498,25 +523,31 @@ MessageBuffer::isDeferredMsgMapEmpty(Addr addr) const
 void
 MessageBuffer::print(std::ostream& out) const
 {
+    auto lock = parallelLock();
     ccprintf(out, "[MessageBuffer: ");
     if (m_consumer != NULL) {
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
+    std::vector<MsgPtr> copy;
+    copy.reserve(m_msg_queue.size());
+    m_msg_queue.forEach([&copy](const MsgPtr &msg) {
+        copy.push_back(msg);
+        return false;
+    });
     ccprintf(out, "%s] %s", copy, name());
 }
 
 bool
 MessageBuffer::isReady(Tick current_time) const
 {
+    auto lock = parallelLock();
     assert(m_time_last_time_pop <= current_time);
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = !m_msg_queue.empty() &&
+                   (m_msg_queue.front()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -527,48 +558,45 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    auto lock = parallelLock();
+    if (m_msg_queue.empty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return m_msg_queue.front()->getLastEnqueueTime();
 }
 
 uint32_t
 MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 {
+    auto lock = parallelLock();
     DPRINTF(RubyQueue, "functional %s for %#x\n",
             is_read ? "read" : "write", pkt->getAddr());
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
-    // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    // Returns true if the access is complete
+    auto access = [&](const MsgPtr &msg_ptr) {
+        Message *msg = msg_ptr.get();
         if (is_read && !mask && msg->functionalRead(pkt))
-            return 1;
+            return true;
         else if (is_read && mask && msg->functionalRead(pkt, *mask))
             num_functional_accesses++;
         else if (!is_read && msg->functionalWrite(pkt))
             num_functional_accesses++;
-    }
+        return false;
+    };
 
-    // Check the stall queue and write any messages that may
+    // Check the queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
+    if (m_msg_queue.forEach(access))
+        return 1;
 
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
+    // Check the stall map and write any messages that may
+    // correspond to the address in the packet.
+    for (const auto &stalled : m_stall_msg_map) {
+        for (const MsgPtr &msg : stalled.second) {
+            if (access(msg))
                 return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
         }
     }
 
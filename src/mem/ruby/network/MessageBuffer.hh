@@ -50,6 +50,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -60,6 +61,7 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/TickBucketQueue.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -92,17 +94,20 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
-        enqueue(m, current_time, delta);
+        auto lock = parallelLock();
+        MsgPtr message = m_msg_queue.pop();
+        enqueue(std::move(message), current_time, delta);
     }
 
     bool areNSlotsAvailable(unsigned int n, Tick curTime);
     int getPriority() { return m_priority_rank; }
     void setPriority(int rank) { m_priority_rank = rank; }
-    void setConsumer(Consumer* consumer)
+    /**
+     * @param port If not negative, the consumer's input port for this
+     *        buffer, which is flagged with Consumer::setPortPending()
+     *        whenever the buffer holds messages.
+     */
+    void setConsumer(Consumer* consumer, int port = -1)
     {
         DPRINTF(RubyQueue, "Setting consumer: %s\n", *consumer);
         if (m_consumer != NULL) {
@@ -111,6 +116,8 @@ class MessageBuffer : public SimObject
                   *consumer, *this, *m_consumer);
         }
         m_consumer = consumer;
+        m_consumer_port = port;
+        updatePortPending();
     }
 
     Consumer* getConsumer() { return m_consumer; }
@@ -121,7 +128,12 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &
+    peekMsgPtr() const
+    {
+        auto lock = parallelLock();
+        return m_msg_queue.front();
+    }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta);
 
@@ -140,12 +152,20 @@ class MessageBuffer : public SimObject
     //! Updates the delay cycles of the message at the head of the queue,
     //! removes it from the queue and returns its total delay.
     Tick dequeue(Tick current_time, bool decrement_messages = true);
+    //! As above, also handing over the message to the caller.
+    Tick dequeue(Tick current_time, MsgPtr &message,
+                 bool decrement_messages = true);
 
     void registerDequeueCallback(std::function<void()> callback);
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool
+    isEmpty() const
+    {
+        auto lock = parallelLock();
+        return m_msg_queue.empty();
+    }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -193,7 +213,9 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    typedef std::vector<MsgPtr> StalledMsgList;
+
+    void reanalyzeList(StalledMsgList &, Tick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -201,26 +223,70 @@ class MessageBuffer : public SimObject
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
+    //! Input port of the consumer, or -1 if it doesn't track its ports
+    int m_consumer_port;
+
+    /**
+     * In parallel mode, the producer and the consumer of a buffer may be
+     * on different event queues, so all accesses to the queue are
+     * serialized.
+     */
+    mutable std::recursive_mutex m_mutex;
+
+    std::unique_lock<std::recursive_mutex>
+    parallelLock() const
+    {
+        std::unique_lock<std::recursive_mutex> lock(m_mutex, std::defer_lock);
+        if (inParallelMode)
+            lock.lock();
+        return lock;
+    }
+
+    void
+    updatePortPending()
+    {
+        if (m_consumer_port >= 0)
+            m_consumer->setPortPending(m_consumer_port, !m_msg_queue.empty());
+    }
+
+    /** Orders messages by arrival time and then by enqueue order. */
+    struct MsgOrder
+    {
+        static Tick
+        time(const MsgPtr &msg)
+        {
+            return msg->getLastEnqueueTime();
+        }
+
+        static uint64_t
+        order(const MsgPtr &msg)
+        {
+            return msg->getMsgCounter();
+        }
+    };
+
+    /** The messages in the buffer, ordered by MsgOrder. */
+    TickBucketQueue<MsgPtr, MsgOrder> m_msg_queue;
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
+    // The stalled messages can be kept in a hash map since the order in
+    // which they are moved back to m_msg_queue doesn't matter, they are
+    // always ordered by arrival time and enqueue order there
+    typedef std::unordered_map<Addr, StalledMsgList> StallMsgMapType;
 
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
-     * in the m_stall_msg_map. Messages are held there until the receiver
-     * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * request, the stalled message is removed from the m_msg_queue and
+     * placed in the m_stall_msg_map. Messages are held there until the
+     * receiver requests they be reanalyzed, at which point they are moved
+     * back to m_msg_queue.
      *
-     * NOTE: The stall map holds messages in the order in which they were
-     * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
-     * older requests with younger ones.
+     * NOTE: Messages keep their arrival time and enqueue order while
+     * stalled, so when a line is unblocked, they are dequeued before any
+     * younger messages. This prevents starving older requests with
+     * younger ones.
      */
     StallMsgMapType m_stall_msg_map;
 
@@ -236,7 +302,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the m_msg_queue and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALLINK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALLINK_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Latency model of a single link of the analytical network.
+ *
+ * A message crossing the link pays the latency of the link, the time
+ * to serialize it at the bandwidth of the link, and a queueing delay.
+ * The queueing delay is the mean waiting time of an M/D/1 queue,
+ * rho * S / (2 * (1 - rho)), where S is the serialization time of the
+ * message and rho the utilization of the link. The utilization is
+ * measured over the current and the previous window of a fixed number
+ * of cycles, so that it follows changes in the load of the link.
+ *
+ * All times are in cycles of the network. They are doubles so that
+ * fractional delays add up along a path instead of being rounded away
+ * at every hop.
+ */
+class AnalyticalLink
+{
+  public:
+    /**
+     * @param latency Latency of the link in cycles.
+     * @param bandwidth Bandwidth of the link in bytes per cycle.
+     * @param window Length of a utilization window in cycles.
+     */
+    AnalyticalLink(uint64_t latency, int bandwidth, uint64_t window)
+        : latency(latency), bandwidth(bandwidth), window(window)
+    {
+        assert(bandwidth > 0 && window > 0);
+    }
+
+    /** Cycles needed to put a message of the given size on the link. */
+    double
+    serialization(int bytes) const
+    {
+        return std::max<double>(1, (bytes + bandwidth - 1) / bandwidth);
+    }
+
+    /** Utilization of the link as seen by a message at cycle now. */
+    double
+    utilization(double now)
+    {
+        advance(now);
+        const double elapsed = std::max(0.0, now - windowStart);
+        return std::min(1.0, (busyPrev + busyCur) / (window + elapsed));
+    }
+
+    /**
+     * Send a message over the link.
+     *
+     * @param now Cycle at which the message reaches the link. This may
+     *            be in the future, e.g., for later hops of a path.
+     * @param bytes Size of the message.
+     * @param factor Scaling of the queueing delay, see calibration.
+     * @param max_util Cap on the utilization, which bounds the delay
+     *                 of a saturated link.
+     * @param queueing Set to the queueing delay of the message.
+     * @return Total delay of the message on this link.
+     */
+    double
+    traverse(double now, int bytes, double factor, double max_util,
+             double &queueing)
+    {
+        const double rho = std::min(utilization(now), max_util);
+        const double service = serialization(bytes);
+        queueing = factor * rho * service / (2 * (1 - rho));
+
+        busyCur += service;
+        totalBusy += service;
+        totalQueueing += queueing;
+        totalBytes += bytes;
+        messages++;
+
+        return latency + service + queueing;
+    }
+
+    /** Clear the cumulative counters, but not the utilization. */
+    void
+    resetStats()
+    {
+        totalBusy = 0;
+        totalQueueing = 0;
+        totalBytes = 0;
+        messages = 0;
+    }
+
+    const uint64_t latency;
+    const int bandwidth;
+    const uint64_t window;
+
+    /** Cumulative counters for statistics. */
+    double totalBusy = 0;
+    double totalQueueing = 0;
+    uint64_t totalBytes = 0;
+    uint64_t messages = 0;
+
+  private:
+    /** Move the current window forward so that it contains now. */
+    void
+    advance(double now)
+    {
+        if (now < windowStart + window)
+            return;
+
+        const uint64_t passed = (now - windowStart) / window;
+        busyPrev = passed == 1 ? busyCur : 0;
+        busyCur = 0;
+        windowStart += passed * window;
+    }
+
+    double windowStart = 0;
+    double busyCur = 0;
+    double busyPrev = 0;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALLINK_HH__
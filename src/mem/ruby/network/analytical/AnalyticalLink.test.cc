@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/ruby/network/analytical/AnalyticalLink.hh"
+
+using namespace gem5::ruby;
+
+TEST(AnalyticalLinkTest, Serialization)
+{
+    AnalyticalLink link(1, 16, 1000);
+    EXPECT_EQ(link.serialization(1), 1);
+    EXPECT_EQ(link.serialization(16), 1);
+    EXPECT_EQ(link.serialization(17), 2);
+    EXPECT_EQ(link.serialization(72), 5);
+}
+
+/** An idle link only adds its latency and the serialization time. */
+TEST(AnalyticalLinkTest, ZeroLoad)
+{
+    AnalyticalLink link(3, 16, 1000);
+    double queueing;
+    EXPECT_EQ(link.traverse(0, 64, 1.0, 0.95, queueing), 3 + 4);
+    EXPECT_EQ(queueing, 0);
+    EXPECT_EQ(link.messages, 1);
+    EXPECT_EQ(link.totalBusy, 4);
+}
+
+/** The queueing delay follows the M/D/1 waiting time. */
+TEST(AnalyticalLinkTest, QueueingGrowsWithLoad)
+{
+    AnalyticalLink link(1, 16, 100);
+    double queueing, last = 0;
+    for (int i = 0; i < 20; i++) {
+        const double rho = link.utilization(0);
+        link.traverse(0, 64, 1.0, 0.95, queueing);
+        EXPECT_DOUBLE_EQ(queueing, rho * 4 / (2 * (1 - rho)));
+        if (i > 0)
+            EXPECT_GT(queueing, last);
+        last = queueing;
+    }
+
+    // A saturated link is capped at the maximum utilization
+    for (int i = 0; i < 100; i++)
+        link.traverse(0, 64, 1.0, 0.95, queueing);
+    EXPECT_DOUBLE_EQ(queueing, 0.95 * 4 / (2 * 0.05));
+
+    AnalyticalLink scaled(1, 16, 100);
+    for (int i = 0; i < 120; i++)
+        scaled.traverse(0, 64, 2.0, 0.95, last);
+    EXPECT_DOUBLE_EQ(last, 2 * queueing);
+}
+
+/** Utilization only covers the current and the previous window. */
+TEST(AnalyticalLinkTest, WindowDecay)
+{
+    AnalyticalLink link(1, 10, 100);
+    double queueing;
+    for (int i = 0; i < 5; i++)
+        link.traverse(10, 100, 1.0, 0.95, queueing);
+    EXPECT_DOUBLE_EQ(link.utilization(50), 50.0 / 150);
+
+    // The busy cycles move to the previous window
+    EXPECT_DOUBLE_EQ(link.utilization(120), 50.0 / 120);
+
+    // And are forgotten after that
+    EXPECT_EQ(link.utilization(250), 0);
+
+    link.resetStats();
+    EXPECT_EQ(link.messages, 0);
+    EXPECT_EQ(link.totalBusy, 0);
+}
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/analytical/AnalyticalNetwork.hh"
+
+#include <cmath>
+
+#include "base/logging.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+AnalyticalNetwork::Link::Link(const BasicLink *link, int bandwidth,
+                              Cycles window)
+    : model(link->m_latency, bandwidth, window),
+      weight(link->m_weight), name(link->name())
+{
+    // Only keep the last component of the name for the stats
+    const auto pos = name.rfind('.');
+    if (pos != std::string::npos)
+        name = name.substr(pos + 1);
+}
+
+AnalyticalNetwork::AnalyticalNetwork(const Params &p)
+    : Network(p), Consumer(this),
+      m_window(p.utilization_window),
+      m_queueing_factor(p.queueing_factor),
+      m_max_utilization(p.max_utilization),
+      m_ingress_link(m_nodes, -1),
+      networkStats(this)
+{
+    fatal_if(m_max_utilization <= 0 || m_max_utilization >= 1,
+             "max_utilization must be between 0 and 1\n");
+
+    for (auto router : p.routers) {
+        const int id = router->params().router_id;
+        if (id >= m_router_latency.size())
+            m_router_latency.resize(id + 1);
+        m_router_latency[id] = router->params().latency;
+    }
+    m_router_links.resize(m_router_latency.size());
+}
+
+void
+AnalyticalNetwork::init()
+{
+    Network::init();
+
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+
+    // For every router and destination, pick the outgoing link with the
+    // lowest weight that leads to the destination
+    m_routes.assign(m_router_links.size(), std::vector<int>(m_nodes, -1));
+    for (int router = 0; router < m_router_links.size(); router++) {
+        auto &routes = m_routes[router];
+        for (auto &[link, dests] : m_router_links[router]) {
+            for (NodeID global : dests.getAllDest()) {
+                const NodeID dest = getLocalNodeID(global);
+                if (routes[dest] == -1 ||
+                    m_links[link].weight < m_links[routes[dest]].weight) {
+                    routes[dest] = link;
+                }
+            }
+        }
+    }
+    m_router_links.clear();
+
+    m_last_arrival.resize(m_nodes);
+    for (NodeID node = 0; node < m_nodes; node++)
+        m_last_arrival[node].resize(m_fromNetQueues[node].size(), 0);
+}
+
+int
+AnalyticalNetwork::addLink(SwitchID src, BasicLink *link,
+                           const NetDest &routes)
+{
+    m_links.emplace_back(link, link->m_bandwidth_factor, m_window);
+    const int index = m_links.size() - 1;
+    if (src != -1)
+        m_router_links.at(src).emplace_back(index, routes);
+    return index;
+}
+
+// From a switch to an endpoint node
+void
+AnalyticalNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                                  BasicLink* link,
+                                  std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_dest = getLocalNodeID(global_dest);
+    assert(local_dest < m_nodes);
+
+    const int index = addLink(src, link, routing_table_entry[0]);
+    m_links[index].dstNode = local_dest;
+}
+
+// From an endpoint node to a switch
+void
+AnalyticalNetwork::makeExtInLink(NodeID global_src, SwitchID dest,
+                                 BasicLink* link,
+                                 std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+
+    const int index = addLink(-1, link, routing_table_entry[0]);
+    m_links[index].dstRouter = dest;
+    m_ingress_link[local_src] = index;
+
+    for (auto buffer : m_toNetQueues[local_src]) {
+        if (buffer)
+            buffer->setConsumer(this);
+    }
+}
+
+// From a switch to a switch
+void
+AnalyticalNetwork::makeInternalLink(SwitchID src, SwitchID dest,
+                                    BasicLink* link,
+                                    std::vector<NetDest>& routing_table_entry,
+                                    PortDirection src_outport,
+                                    PortDirection dst_inport)
+{
+    const int index = addLink(src, link, routing_table_entry[0]);
+    m_links[index].dstRouter = dest;
+}
+
+double
+AnalyticalNetwork::routeLatency(NodeID src, NodeID dest, int bytes,
+                                double &queueing)
+{
+    const double start = curCycle();
+    double now = start;
+    queueing = 0;
+
+    int link = m_ingress_link[src];
+    for (int hops = 0; ; hops++) {
+        panic_if(link == -1 || hops > m_links.size(),
+                 "%s: No route from node %d to node %d\n",
+                 name(), src, dest);
+
+        Link &l = m_links[link];
+        double link_queueing;
+        now += l.model.traverse(now, bytes, m_queueing_factor,
+                                m_max_utilization, link_queueing);
+        queueing += link_queueing;
+
+        if (l.dstRouter == -1) {
+            assert(l.dstNode == dest);
+            break;
+        }
+        now += m_router_latency[l.dstRouter];
+        link = m_routes[l.dstRouter][dest];
+    }
+
+    return now - start;
+}
+
+bool
+AnalyticalNetwork::deliver(NodeID src, int vnet, const MsgPtr &msg)
+{
+    const Tick now = clockEdge();
+    const std::vector<NodeID> dests = msg->getDestination().getAllDest();
+
+    for (NodeID global : dests) {
+        MessageBuffer *buffer = m_fromNetQueues[getLocalNodeID(global)][vnet];
+        if (!buffer->areNSlotsAvailable(1, now))
+            return false;
+    }
+
+    const int bytes = MessageSizeType_to_int(msg->getMessageSize());
+    for (NodeID global : dests) {
+        const NodeID dest = getLocalNodeID(global);
+        double queueing;
+        const double cycles = routeLatency(src, dest, bytes, queueing);
+        Tick arrival = now + cyclesToTicks(Cycles(std::lround(cycles)));
+
+        // Ordered vnets must not see a later message overtake an
+        // earlier one because its route was less loaded
+        if (m_ordered[vnet]) {
+            arrival = std::max(arrival, m_last_arrival[dest][vnet]);
+            m_last_arrival[dest][vnet] = arrival;
+        }
+
+        MsgPtr out = msg;
+        if (dests.size() > 1) {
+            out = msg->clone();
+            for (int m = 0; m < (int) MachineType_NUM; m++) {
+                if ((global >= MachineType_base_number((MachineType) m)) &&
+                    global < MachineType_base_number((MachineType) (m+1))) {
+                    NetDest personal_dest;
+                    personal_dest.add((MachineID) {(MachineType) m, (global -
+                        MachineType_base_number((MachineType) m))});
+                    out->getDestination() = personal_dest;
+                    break;
+                }
+            }
+        }
+
+        DPRINTF(RubyNetwork, "Message from node %d to node %d vnet %d: "
+                "%.1f cycles, %.1f queueing\n", src, dest, vnet, cycles,
+                queueing);
+
+        m_fromNetQueues[dest][vnet]->enqueue(out, now, arrival - now);
+
+        networkStats.messages++;
+        networkStats.latency += arrival - now;
+        networkStats.queueingLatency += cyclesToTicks(
+            Cycles(std::lround(queueing)));
+    }
+
+    return true;
+}
+
+void
+AnalyticalNetwork::wakeup()
+{
+    const Tick now = clockEdge();
+    bool blocked = false;
+
+    for (NodeID node = 0; node < m_nodes; node++) {
+        for (int vnet = 0; vnet < m_toNetQueues[node].size(); vnet++) {
+            MessageBuffer *buffer = m_toNetQueues[node][vnet];
+            if (!buffer)
+                continue;
+
+            while (buffer->isReady(now)) {
+                if (!deliver(node, vnet, buffer->peekMsgPtr())) {
+                    blocked = true;
+                    break;
+                }
+                buffer->dequeue(now);
+            }
+        }
+    }
+
+    // Retry messages whose destination is full
+    if (blocked)
+        scheduleEvent(Cycles(1));
+}
+
+void
+AnalyticalNetwork::regStats()
+{
+    Network::regStats();
+
+    networkStats.linkUtilization.init(m_links.size());
+    for (int i = 0; i < m_links.size(); i++)
+        networkStats.linkUtilization.subname(i, m_links[i].name);
+}
+
+void
+AnalyticalNetwork::resetStats()
+{
+    Network::resetStats();
+
+    for (auto &link : m_links)
+        link.model.resetStats();
+}
+
+void
+AnalyticalNetwork::collateStats()
+{
+    RubySystem *rs = params().ruby_system;
+    const double cycles = double(curCycle() - rs->getStartCycle());
+    if (cycles <= 0)
+        return;
+
+    for (int i = 0; i < m_links.size(); i++) {
+        networkStats.linkUtilization[i] =
+            m_links[i].model.totalBusy / cycles;
+    }
+}
+
+void
+AnalyticalNetwork::print(std::ostream& out) const
+{
+    out << "[AnalyticalNetwork]";
+}
+
+AnalyticalNetwork::
+NetworkStats::NetworkStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(messages, statistics::units::Count::get(),
+               "Number of messages delivered"),
+      ADD_STAT(latency, statistics::units::Tick::get(),
+               "Total latency of all messages"),
+      ADD_STAT(queueingLatency, statistics::units::Tick::get(),
+               "Total queueing delay of all messages"),
+      ADD_STAT(avgLatency, statistics::units::Rate<
+                   statistics::units::Tick, statistics::units::Count>::get(),
+               "Average latency of a message", latency / messages),
+      ADD_STAT(avgQueueingLatency, statistics::units::Rate<
+                   statistics::units::Tick, statistics::units::Count>::get(),
+               "Average queueing delay of a message",
+               queueingLatency / messages),
+      ADD_STAT(avgZeroLoadLatency, statistics::units::Rate<
+                   statistics::units::Tick, statistics::units::Count>::get(),
+               "Average latency of a message without queueing",
+               (latency - queueingLatency) / messages),
+      ADD_STAT(linkUtilization, statistics::units::Ratio::get(),
+               "Fraction of cycles each link was busy")
+{
+    avgLatency.flags(statistics::nozero | statistics::nonan);
+    avgQueueingLatency.flags(statistics::nozero | statistics::nonan);
+    avgZeroLoadLatency.flags(statistics::nozero | statistics::nonan);
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/Network.hh"
+#include "mem/ruby/network/analytical/AnalyticalLink.hh"
+#include "params/AnalyticalNetwork.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class BasicRouter;
+
+/**
+ * A network that computes the latency of a message instead of moving
+ * it through routers and links.
+ *
+ * Messages are taken from the buffers of the source as soon as they
+ * are ready and are enqueued at the destination with the latency of
+ * the route between the two. The route is the one chosen by the
+ * topology (lowest weight). Every link on the route adds its latency,
+ * the serialization time of the message and a queueing delay derived
+ * from its recent utilization (see AnalyticalLink), and every router
+ * adds its latency.
+ *
+ * This captures the effect of contention at close to the cost of the
+ * simple network, but it does not model back pressure inside the
+ * network: a message only waits in its source buffer when its
+ * destination buffer is full.
+ */
+class AnalyticalNetwork : public Network, public Consumer
+{
+  public:
+    PARAMS(AnalyticalNetwork);
+    AnalyticalNetwork(const Params &p);
+
+    void init() override;
+    void regStats() override;
+    void resetStats() override;
+    void collateStats() override;
+
+    void wakeup() override;
+    void print(std::ostream& out) const override;
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                        std::vector<NetDest>& routing_table_entry) override;
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                       std::vector<NetDest>& routing_table_entry) override;
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport) override;
+
+    // Messages are always in the buffers of the controllers, which are
+    // accessed by the controllers themselves.
+    bool functionalRead(Packet *pkt) override { return false; }
+    bool
+    functionalRead(Packet *pkt, WriteMask& mask) override
+    {
+        return false;
+    }
+    uint32_t functionalWrite(Packet *pkt) override { return 0; }
+
+  private:
+    struct Link
+    {
+        Link(const BasicLink *link, int bandwidth, Cycles window);
+
+        AnalyticalLink model;
+        int weight;
+        std::string name;
+
+        /** Router at the end of the link, or -1 for links to a node. */
+        int dstRouter = -1;
+        /** Local ID of the node at the end of an external link. */
+        NodeID dstNode = 0;
+    };
+
+    int addLink(SwitchID src, BasicLink *link, const NetDest &routes);
+
+    /**
+     * Deliver a message to all its destinations.
+     * @return False if a destination buffer is full.
+     */
+    bool deliver(NodeID src, int vnet, const MsgPtr &msg);
+
+    /** Latency from a node to another one, in cycles. */
+    double routeLatency(NodeID src, NodeID dest, int bytes,
+                        double &queueing);
+
+    const Cycles m_window;
+    const double m_queueing_factor;
+    const double m_max_utilization;
+
+    /** Latency of each router, indexed by router ID. */
+    std::vector<Cycles> m_router_latency;
+
+    std::vector<Link> m_links;
+
+    /** Link from each node into the network, indexed by local ID. */
+    std::vector<int> m_ingress_link;
+
+    /**
+     * Outgoing links of each router and the reachable nodes of each of
+     * them, used to build m_routes.
+     */
+    std::vector<std::vector<std::pair<int, NetDest>>> m_router_links;
+
+    /** Next link for each router and destination node. */
+    std::vector<std::vector<int>> m_routes;
+
+    /** Last arrival time at each destination buffer of ordered vnets. */
+    std::vector<std::vector<Tick>> m_last_arrival;
+
+    struct NetworkStats : public statistics::Group
+    {
+        NetworkStats(statistics::Group *parent);
+
+        statistics::Scalar messages;
+        statistics::Scalar latency;
+        statistics::Scalar queueingLatency;
+        statistics::Formula avgLatency;
+        statistics::Formula avgQueueingLatency;
+        statistics::Formula avgZeroLoadLatency;
+        statistics::Vector linkUtilization;
+    } networkStats;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_ANALYTICAL_ANALYTICALNETWORK_HH__
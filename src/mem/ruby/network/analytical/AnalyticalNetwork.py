@@ -0,0 +1,60 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Network import RubyNetwork
+from m5.params import *
+
+
+class AnalyticalNetwork(RubyNetwork):
+    """
+    A network that computes the latency of each message from the links
+    and routers on its route instead of simulating them. It uses the
+    same topologies, routers and links as the simple network, with the
+    bandwidth_factor of a link being its bandwidth in bytes per cycle.
+
+    The queueing delay on a link grows with its utilization. To
+    calibrate it against garnet, run a representative workload with
+    both networks and set queueing_factor to
+
+        (garnet average_packet_network_latency
+         - analytical avgZeroLoadLatency) / analytical avgQueueingLatency
+
+    where the analytical stats come from a run with queueing_factor=1.
+    """
+
+    type = "AnalyticalNetwork"
+    cxx_header = "mem/ruby/network/analytical/AnalyticalNetwork.hh"
+    cxx_class = "gem5::ruby::AnalyticalNetwork"
+
+    utilization_window = Param.Cycles(
+        1000, "Number of cycles over which link utilization is measured"
+    )
+    max_utilization = Param.Float(
+        0.95, "Cap on the link utilization used for queueing delays"
+    )
+    queueing_factor = Param.Float(
+        1.0, "Scaling of the queueing delay on every link"
+    )
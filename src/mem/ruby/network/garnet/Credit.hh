@@ -64,6 +64,21 @@ class Credit : public flit
 
     ~Credit() {};
 
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Credit));
+        return pool_alloc::FixedSizePool<sizeof(Credit),
+            alignof(Credit)>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        pool_alloc::FixedSizePool<sizeof(Credit),
+            alignof(Credit)>::deallocate(ptr);
+    }
+
     bool is_free_signal() { return m_is_free_signal; }
 
   private:
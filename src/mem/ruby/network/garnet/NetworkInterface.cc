@@ -56,7 +56,7 @@ NetworkInterface::NetworkInterface(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(0),
     m_vc_allocator(m_virtual_networks, 0),
     m_deadlock_threshold(p.garnet_deadlock_threshold),
-    vc_busy_counter(m_virtual_networks, 0)
+    vc_busy_since(m_virtual_networks, MaxTick)
 {
     m_stall_count.resize(m_virtual_networks);
     niOutVcs.resize(0);
@@ -473,19 +473,31 @@ NetworkInterface::calculateVC(int vnet)
 
         if (outVcState[(vnet*m_vc_per_vnet) + delta].isInState(
                     IDLE_, curTick())) {
-            vc_busy_counter[vnet] = 0;
+            vc_busy_since[vnet] = MaxTick;
             return ((vnet*m_vc_per_vnet) + delta);
         }
     }
 
-    vc_busy_counter[vnet] += 1;
-    panic_if(vc_busy_counter[vnet] > m_deadlock_threshold,
+    if (vc_busy_since[vnet] == MaxTick)
+        vc_busy_since[vnet] = curTick();
+    panic_if(curTick() - vc_busy_since[vnet] >
+        cyclesToTicks(Cycles(m_deadlock_threshold)),
         "%s: Possible network deadlock in vnet: %d at time: %llu \n",
         name(), vnet, curTick());
 
     return -1;
 }
 
+bool
+NetworkInterface::hasFreeVC(int vnet)
+{
+    for (int i = 0; i < m_vc_per_vnet; i++) {
+        if (outVcState[(vnet*m_vc_per_vnet) + i].isInState(IDLE_, curTick()))
+            return true;
+    }
+    return false;
+}
+
 void
 NetworkInterface::scheduleOutputPort(OutputPort *oPort)
 {
@@ -625,24 +637,37 @@ NetworkInterface::get_vnet(int vc)
 // Wakeup the NI in the next cycle if there are waiting
 // messages in the protocol buffer, or waiting flits in the
 // output VC buffer.
+// Messages and flits that are waiting for a free VC or a credit are
+// only retried once a credit arrives, which wakes up the NI. If no
+// credit arrives, the NI still wakes up once the deadlock threshold of
+// a waiting vnet has passed, so that calculateVC() reports it.
 // Also check if we have to reschedule because of a clock period
 // difference.
 void
 NetworkInterface::checkReschedule()
 {
-    for (const auto& it : inNode_ptr) {
-        if (it == nullptr) {
+    for (int vnet = 0; vnet < inNode_ptr.size(); ++vnet) {
+        MessageBuffer *b = inNode_ptr[vnet];
+        if (b == nullptr) {
             continue;
         }
 
-        while (it->isReady(clockEdge())) { // Is there a message waiting
-            scheduleEvent(Cycles(1));
-            return;
+        // Is there a message waiting
+        if (b->isReady(clockEdge())) {
+            if (hasFreeVC(vnet)) {
+                scheduleEvent(Cycles(1));
+                return;
+            }
+            if (vc_busy_since[vnet] != MaxTick) {
+                scheduleEventAbsolute(vc_busy_since[vnet] +
+                    cyclesToTicks(Cycles(m_deadlock_threshold + 1)));
+            }
         }
     }
 
-    for (auto& ni_out_vc : niOutVcs) {
-        if (ni_out_vc.isReady(clockEdge(Cycles(1)))) {
+    for (int vc = 0; vc < niOutVcs.size(); vc++) {
+        if (niOutVcs[vc].isReady(clockEdge(Cycles(1))) &&
+            outVcState[vc].has_credit()) {
             scheduleEvent(Cycles(1));
             return;
         }
@@ -291,11 +291,12 @@ class NetworkInterface : public ClockedObject, public Consumer
     // The Message buffers that provides messages to the protocol
     std::vector<MessageBuffer *> outNode_ptr;
     // When a vc stays busy for a long time, it indicates a deadlock
-    std::vector<int> vc_busy_counter;
+    std::vector<Tick> vc_busy_since;
 
     void checkStallQueue();
     bool flitisizeMessage(MsgPtr msg_ptr, int vnet);
     int calculateVC(int vnet);
+    bool hasFreeVC(int vnet);
 
 
     void scheduleOutputPort(OutputPort *oPort);
@@ -392,6 +392,9 @@ SwitchAllocator::vc_allocate(int outport, int inport, int invc)
 
 // Wakeup the router next cycle to perform SA again
 // if there are flits ready.
+// Flits that are waiting for a free output VC or for a credit cannot
+// make progress until a credit arrives, which wakes up the router, so
+// the router sleeps rather than retrying them every cycle.
 void
 SwitchAllocator::check_for_wakeup()
 {
@@ -402,8 +405,14 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (!input_unit->need_stage(j, SA_, nextCycle))
+                continue;
+
+            if (!input_unit->need_stage(j, SA_, curTick()) ||
+                send_allowed(i, j, input_unit->get_outport(j),
+                             input_unit->get_outvc(j))) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
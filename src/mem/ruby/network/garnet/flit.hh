@@ -34,6 +34,7 @@
 #include <cassert>
 #include <iostream>
 
+#include "base/pool_alloc.hh"
 #include "base/types.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
@@ -56,6 +57,23 @@ class flit
 
     virtual ~flit(){};
 
+    // Every flit is allocated when it is injected and freed when it is
+    // ejected, so take them from a pool rather than the heap.
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(flit));
+        return pool_alloc::FixedSizePool<sizeof(flit),
+            alignof(flit)>::allocate();
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        pool_alloc::FixedSizePool<sizeof(flit),
+            alignof(flit)>::deallocate(ptr);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
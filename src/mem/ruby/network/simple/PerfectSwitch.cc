@@ -72,9 +72,8 @@ PerfectSwitch::init(SimpleNetwork *network_ptr)
 {
     m_network_ptr = network_ptr;
 
-    for (int i = 0;i < m_virtual_networks;++i) {
-        m_pending_message_count.push_back(0);
-    }
+    m_pending_message_count =
+        std::vector<std::atomic<int>>(m_virtual_networks);
 }
 
 void
@@ -171,7 +170,7 @@ PerfectSwitch::operateVnet(int vnet)
         }
         DPRINTF(RubyNetwork, "vnet %d: %d pending msgs. "
                             "Checking port %d first\n",
-                vnet, m_pending_message_count[vnet], start_in_port);
+                vnet, m_pending_message_count[vnet].load(), start_in_port);
         // check all ports starting with the one with the oldest message
         for (int i = 0; i < in.size(); ++i) {
             int in_port = (i + start_in_port) % in.size();
@@ -245,7 +244,7 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int vnet)
 
         // Dequeue msg
         buffer->dequeue(current_time);
-        m_pending_message_count[vnet]--;
+        m_pending_message_count[vnet].fetch_sub(1, std::memory_order_relaxed);
 
         // Enqueue it - for all outgoing queues
         for (int i=0; i<output_links.size(); i++) {
@@ -301,7 +300,8 @@ PerfectSwitch::wakeup()
 void
 PerfectSwitch::storeEventInfo(int info)
 {
-    m_pending_message_count[info]++;
+    // In parallel mode, this may be called from other event queues
+    m_pending_message_count[info].fetch_add(1, std::memory_order_relaxed);
 }
 
 void
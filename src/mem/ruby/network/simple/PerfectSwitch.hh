@@ -48,6 +48,7 @@
 #ifndef __MEM_RUBY_NETWORK_SIMPLE_PERFECTSWITCH_HH__
 #define __MEM_RUBY_NETWORK_SIMPLE_PERFECTSWITCH_HH__
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -126,7 +127,7 @@ class PerfectSwitch : public Consumer
     int m_wakeups_wo_switch;
 
     SimpleNetwork* m_network_ptr;
-    std::vector<int> m_pending_message_count;
+    std::vector<std::atomic<int>> m_pending_message_count;
 
     MessageBuffer* inBuffer(int in_port, int vnet) const;
 };
@@ -41,9 +41,12 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_RUBYREQUEST_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_RUBYREQUEST_HH__
 
+#include <memory>
 #include <ostream>
+#include <utility>
 #include <vector>
 
+#include "base/pool_alloc.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -214,8 +217,20 @@ class RubyRequest : public Message
     }
 
     RubyRequest(Tick curTime) : Message(curTime) {}
-    MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+
+    /**
+     * Allocate a request from a per-thread pool. Takes the same
+     * arguments as the constructors.
+     */
+    template <typename... Args>
+    static std::shared_ptr<RubyRequest>
+    create(Args&&... args)
+    {
+        return std::allocate_shared<RubyRequest>(
+            PoolAllocator<RubyRequest>(), std::forward<Args>(args)...);
+    }
+
+    MsgPtr clone() const { return create(*this); }
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
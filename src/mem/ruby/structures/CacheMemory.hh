@@ -168,6 +168,21 @@ class CacheMemory : public SimObject
     int findTagInSet(int64_t line, Addr tag) const;
     int findTagInSetIgnorePermissions(int64_t cacheSet, Addr tag) const;
 
+    // Search the tags of a set. Returns -1 if the tag is not found.
+    int searchTags(int64_t cacheSet, Addr tag) const;
+
+    AbstractCacheEntry *&
+    entryAt(int64_t cacheSet, int way)
+    {
+        return m_cache[cacheSet * m_cache_assoc + way];
+    }
+
+    AbstractCacheEntry *
+    entryAt(int64_t cacheSet, int way) const
+    {
+        return m_cache[cacheSet * m_cache_assoc + way];
+    }
+
     // Private copy constructor and assignment operator
     CacheMemory(const CacheMemory& obj);
     CacheMemory& operator=(const CacheMemory& obj);
@@ -176,10 +191,18 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
+    /**
+     * The entries of all sets, one set after the other. Tags are found
+     * either through a hash map from the line address to the way, or,
+     * when m_flat_tag_index is set, by searching an array holding the
+     * line address of every way, also in set order. The latter avoids
+     * the hash map nodes and only touches one or two cache lines per
+     * lookup, which pays off for large caches.
+     */
+    std::vector<AbstractCacheEntry*> m_cache;
     std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    std::vector<Addr> m_tags;
+    bool m_flat_tag_index;
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
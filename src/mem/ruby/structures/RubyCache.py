@@ -40,6 +40,11 @@ class RubyCache(SimObject):
     replacement_policy = Param.BaseReplacementPolicy(TreePLRURP(), "")
     start_index_bit = Param.Int(6, "index start, default 6 for 64-byte line")
     is_icache = Param.Bool(False, "is instruction only cache")
+    flat_tag_index = Param.Bool(
+        False,
+        "Find tags by searching a contiguous tag array per set instead of "
+        "using a hash map. Recommended for large caches.",
+    )
     block_size = Param.MemorySize(
         "0B", "block size in bytes. 0 means default RubyBlockSize"
     )
@@ -29,6 +29,8 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <algorithm>
+
 #include "debug/RubyCacheTrace.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
@@ -39,6 +41,41 @@ namespace gem5
 namespace ruby
 {
 
+namespace
+{
+
+/** Flag of the type byte of records whose line is all zero. */
+constexpr uint8_t ZeroDataFlag = 0x80;
+
+static_assert(RubyRequestType_NUM < ZeroDataFlag,
+              "Request types must fit in the type byte of a trace record");
+
+void
+putVarint(std::vector<uint8_t> &buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    buf.push_back(uint8_t(value));
+}
+
+uint64_t
+getVarint(const uint8_t *buf, uint64_t size, uint64_t &pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        fatal_if(pos >= size, "Truncated ruby cache trace\n");
+        const uint8_t byte = buf[pos++];
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    fatal("Corrupt ruby cache trace\n");
+}
+
+} // anonymous namespace
+
 void
 TraceRecord::print(std::ostream& out) const
 {
@@ -57,10 +94,12 @@ CacheRecorder::CacheRecorder()
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<Sequencer*>& seq_map,
-                             uint64_t block_size_bytes)
+                             uint64_t block_size_bytes,
+                             uint64_t trace_version,
+                             bool parallel)
     : m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
-      m_seq_map(seq_map),  m_bytes_read(0), m_records_read(0),
+      m_seq_map(seq_map), m_records_read(0),
       m_records_flushed(0), m_block_size_bytes(block_size_bytes)
 {
     if (m_uncompressed_trace != NULL) {
@@ -71,6 +110,16 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
             panic("Recorded cache block size (%d) < current block size (%d) !!",
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
+
+        if (trace_version == LegacyTraceVersion) {
+            decodeLegacyTrace();
+        } else if (trace_version == TraceVersion) {
+            decodeTrace();
+        } else {
+            fatal("Unsupported ruby cache trace version %d\n",
+                  trace_version);
+        }
+        makeShards(parallel);
     }
 }
 
@@ -83,6 +132,77 @@ CacheRecorder::~CacheRecorder()
     m_seq_map.clear();
 }
 
+void
+CacheRecorder::decodeLegacyTrace()
+{
+    const uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    for (uint64_t pos = 0; pos + record_size <= m_uncompressed_trace_size;
+         pos += record_size) {
+        TraceRecord* rec = (TraceRecord*) (m_uncompressed_trace + pos);
+        fatal_if(rec->m_cntrl_id >= m_seq_map.size(),
+                 "Corrupt ruby cache trace\n");
+        m_fetch_records.push_back({rec->m_data_address, rec->m_type,
+                                   rec->m_cntrl_id, rec->m_data});
+    }
+}
+
+void
+CacheRecorder::decodeTrace()
+{
+    m_zero_block.assign(m_block_size_bytes, 0);
+
+    const uint8_t *buf = m_uncompressed_trace;
+    const uint64_t size = m_uncompressed_trace_size;
+    uint64_t pos = 0;
+    uint64_t line = 0;
+    while (pos < size) {
+        const uint8_t type = buf[pos++];
+        const int cntrl = getVarint(buf, size, pos);
+        const uint64_t delta = getVarint(buf, size, pos);
+        line += (delta >> 1) ^ -(delta & 1);
+
+        FetchRecord rec;
+        rec.address = line * m_block_size_bytes;
+        rec.type = RubyRequestType(type & ~ZeroDataFlag);
+        rec.cntrl = cntrl;
+        if (type & ZeroDataFlag) {
+            rec.data = m_zero_block.data();
+        } else {
+            fatal_if(pos + m_block_size_bytes > size,
+                     "Truncated ruby cache trace\n");
+            rec.data = m_uncompressed_trace + pos;
+            pos += m_block_size_bytes;
+        }
+
+        fatal_if(rec.type >= RubyRequestType_NUM ||
+                 cntrl >= m_seq_map.size(),
+                 "Corrupt ruby cache trace\n");
+        m_fetch_records.push_back(rec);
+    }
+}
+
+void
+CacheRecorder::makeShards(bool parallel)
+{
+    for (const auto &rec : m_fetch_records) {
+        Sequencer *seq = m_seq_map[rec.cntrl];
+        assert(seq != NULL);
+        auto it = m_seq_shard.find(seq);
+        if (it == m_seq_shard.end()) {
+            // Without parallel replay, all sequencers share one shard
+            if (parallel || m_shards.empty())
+                m_shards.emplace_back();
+            it = m_seq_shard.emplace(seq, m_shards.size() - 1).first;
+        }
+        m_shards[it->second].records.push_back(rec);
+    }
+    m_fetch_records.clear();
+    m_fetch_records.shrink_to_fit();
+
+    DPRINTF(RubyCacheTrace, "Replaying the cache trace with %d shards\n",
+            m_shards.size());
+}
+
 void
 CacheRecorder::enqueueNextFlushRequest()
 {
@@ -106,52 +226,71 @@ CacheRecorder::enqueueNextFlushRequest()
 }
 
 void
-CacheRecorder::enqueueNextFetchRequest()
-{
-    if (m_bytes_read < m_uncompressed_trace_size) {
-        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
-
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
-
-        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
-                rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
-
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                Request::funcRequestorId);
-            }
-
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
+CacheRecorder::startFetchRequests()
+{
+    for (auto &shard : m_shards)
+        issueFetchRequest(shard);
+}
+
+void
+CacheRecorder::enqueueNextFetchRequest(Sequencer *seq)
+{
+    auto it = m_seq_shard.find(seq);
+    assert(it != m_seq_shard.end());
+    Shard &shard = m_shards[it->second];
+
+    assert(shard.outstanding > 0);
+    if (--shard.outstanding == 0)
+        issueFetchRequest(shard);
+}
+
+void
+CacheRecorder::issueFetchRequest(Shard &shard)
+{
+    if (shard.next == shard.records.size()) {
+        DPRINTF(RubyCacheTrace, "Fetched %d records\n", m_records_read);
+        return;
+    }
+
+    const FetchRecord &rec = shard.records[shard.next++];
+    DPRINTF(RubyCacheTrace, "Issuing %s for %#x from controller %d\n",
+            RubyRequestType_to_string(rec.type), rec.address, rec.cntrl);
+
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
+
+        if (rec.type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                rec.address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                Request::funcRequestorId);
+        } else if (rec.type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                rec.address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(),
+                Request::INST_FETCH, Request::funcRequestorId);
+        } else {
+            requestType = MemCmd::WriteReq;
+            req = std::make_shared<Request>(
+                rec.address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                Request::funcRequestorId);
         }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
-    } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(rec.data + rec_bytes_read);
+
+        Sequencer* m_sequencer_ptr = m_seq_map[rec.cntrl];
+        assert(m_sequencer_ptr != NULL);
+        shard.outstanding++;
+        m_sequencer_ptr->makeRequest(pkt);
     }
+
+    m_records_read++;
 }
 
 void
@@ -176,35 +315,41 @@ CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
 {
     std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
 
-    int size = m_records.size();
-    uint64_t current_size = 0;
-    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
-
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
+    std::vector<uint8_t> trace;
+    trace.reserve(total_size);
+
+    uint64_t prev_line = 0;
+    for (TraceRecord *rec : m_records) {
+        const bool zero = std::all_of(rec->m_data,
+                                      rec->m_data + m_block_size_bytes,
+                                      [](uint8_t b) { return b == 0; });
+        const uint64_t line = rec->m_data_address / m_block_size_bytes;
+        const int64_t delta = line - prev_line;
+        prev_line = line;
+
+        trace.push_back(uint8_t(rec->m_type) | (zero ? ZeroDataFlag : 0));
+        putVarint(trace, rec->m_cntrl_id);
+        putVarint(trace, (uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+        if (!zero) {
+            trace.insert(trace.end(), rec->m_data,
+                         rec->m_data + m_block_size_bytes);
         }
 
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
-        current_size += record_size;
+        free(rec);
+    }
+    m_records.clear();
 
-        free(m_records[i]);
-        m_records[i] = NULL;
+    if (trace.size() > total_size) {
+        uint8_t* new_buf = new (std::nothrow) uint8_t[trace.size()];
+        if (new_buf == NULL) {
+            fatal("Unable to allocate buffer of size %s\n", trace.size());
+        }
+        delete [] *buf;
+        *buf = new_buf;
     }
+    std::copy(trace.begin(), trace.end(), *buf);
 
-    m_records.clear();
-    return current_size;
+    return trace.size();
 }
 
 uint64_t
@@ -35,6 +35,7 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <unordered_map>
 #include <vector>
 
 #include "base/types.hh"
@@ -73,16 +74,33 @@ class TraceRecord
 class CacheRecorder
 {
   public:
+    /*!
+     * Versions of the cache trace. Version 1 is an array of TraceRecord.
+     * Version 2 stores, for every record, a byte holding the request
+     * type, the controller as a varint, the distance to the previous
+     * line as a zigzag varint and the data of the line, which is left
+     * out if it is all zero.
+     */
+    static constexpr uint64_t LegacyTraceVersion = 1;
+    static constexpr uint64_t TraceVersion = 2;
+
     CacheRecorder();
     ~CacheRecorder();
 
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<Sequencer*>& SequencerMap,
-                  uint64_t block_size_bytes);
+                  uint64_t block_size_bytes,
+                  uint64_t trace_version = TraceVersion,
+                  bool parallel = false);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
+    /*!
+     * Encode the records in the current trace format into *data, which
+     * is reallocated as needed.
+     * @return The size of the trace in bytes.
+     */
     uint64_t aggregateRecords(uint8_t **data, uint64_t size);
 
     uint64_t getNumRecords() const;
@@ -98,27 +116,58 @@ class CacheRecorder
     void enqueueNextFlushRequest();
 
     /*!
-     * Function for fetching warming up the memory and the caches. It goes
+     * Functions for warming up the memory and the caches. They go
      * through the recorded contents of the caches, as available in the
-     * checkpoint and issues fetch requests. Except for the first one, a
-     * fetch request is issued only after the previous one has completed.
-     * It should be possible to use this with any protocol.
+     * checkpoint and issue fetch requests. Each sequencer has at most one
+     * record in flight, and the next one is issued once it has completed.
+     * By default, only one sequencer replays its records at a time, in
+     * the recorded order. In parallel mode, all sequencers replay their
+     * own records at the same time. It should be possible to use this
+     * with any protocol.
      */
-    void enqueueNextFetchRequest();
+    void startFetchRequests();
+    void enqueueNextFetchRequest(Sequencer *seq);
 
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /** A record of the trace being replayed. */
+    struct FetchRecord
+    {
+        Addr address;
+        RubyRequestType type;
+        int cntrl;
+        uint8_t *data;
+    };
+
+    /** Records replayed one after the other. */
+    struct Shard
+    {
+        std::vector<FetchRecord> records;
+        size_t next = 0;
+        int outstanding = 0;
+    };
+
+    void decodeLegacyTrace();
+    void decodeTrace();
+    void makeShards(bool parallel);
+    void issueFetchRequest(Shard &shard);
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
     std::vector<Sequencer*> m_seq_map;
-    uint64_t m_bytes_read;
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+
+    std::vector<FetchRecord> m_fetch_records;
+    std::vector<Shard> m_shards;
+    std::unordered_map<Sequencer*, int> m_seq_shard;
+    /** Shared data of records whose line is all zero. */
+    std::vector<uint8_t> m_zero_block;
 };
 
 inline bool
@@ -189,6 +189,7 @@ GPUCoalescer::GPUCoalescer(const Params &p)
       issueEvent([this]{ completeIssue(); }, "Issue coalesced request",
                  false, Event::Progress_Event_Pri),
       uncoalescedTable(this),
+      coalescedTable(p.max_outstanding_requests),
       deadlockCheckEvent([this]{ wakeup(); }, "GPUCoalescer deadlock check"),
       gmTokenPort(name() + ".gmTokenPort")
 {
@@ -285,7 +286,7 @@ GPUCoalescer::wakeup()
 {
     Cycles current_time = curCycle();
     for (auto& requestList : coalescedTable) {
-        for (auto& req : requestList.second) {
+        for (auto& req : requestList) {
             if (current_time - req->getIssueTime() > m_deadlock_threshold) {
                 std::stringstream ss;
                 printRequestTable(ss);
@@ -313,8 +314,8 @@ GPUCoalescer::printRequestTable(std::stringstream& ss)
        << " outstanding requests in the coalesced table\n";
 
     for (auto& requestList : coalescedTable) {
-        for (auto& request : requestList.second) {
-            ss << "\tAddr: " << printAddress(requestList.first) << "\n"
+        for (auto& request : requestList) {
+            ss << "\tAddr: " << printAddress(requestList.address()) << "\n"
                << "\tInstruction sequence number: "
                << request->getSeqNum() << "\n"
                << "\t\tType: "
@@ -741,8 +742,8 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
         if (!coalescedTable.count(line_addr)) {
             // If there is no outstanding request for this line address,
             // create a new coalecsed request and issue it immediately.
+            coalescedTable[line_addr].emplace_back(creq);
             auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
             if (!coalescedReqs.count(seqNum)) {
                 coalescedReqs.insert(std::make_pair(seqNum, reqList));
             } else {
@@ -752,7 +753,7 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
             // The request is for a line address that is already outstanding
             // but for a different instruction. Add it as a new request to be
             // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
+            coalescedTable.at(line_addr).emplace_back(creq);
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
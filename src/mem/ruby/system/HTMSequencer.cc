@@ -173,9 +173,7 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
-
-        auto &seq_req_list = m_RequestTable[address];
+        auto &seq_req_list = m_RequestTable.at(address);
         while (!seq_req_list.empty()) {
             SequencerRequest &request = seq_req_list.front();
 
@@ -78,7 +78,7 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
-      m_cache_recorder(NULL)
+      m_parallel_warmup(p.parallel_warmup), m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
@@ -175,7 +175,8 @@ RubySystem::~RubySystem()
 void
 RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
                               uint64_t cache_trace_size,
-                              uint64_t block_size_bytes)
+                              uint64_t block_size_bytes,
+                              uint64_t trace_version)
 {
     std::vector<Sequencer*> sequencer_map;
     Sequencer* sequencer_ptr = NULL;
@@ -202,7 +203,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         sequencer_map, block_size_bytes);
+                                         sequencer_map, block_size_bytes,
+                                         trace_version, m_parallel_warmup);
 }
 
 void
@@ -338,8 +340,11 @@ RubySystem::serialize(CheckpointOut &cp) const
     std::string cache_trace_file = name() + ".cache.gz";
     writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
 
+    uint64_t cache_trace_version = CacheRecorder::TraceVersion;
+
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
+    SERIALIZE_SCALAR(cache_trace_version);
 }
 
 void
@@ -398,8 +403,12 @@ RubySystem::unserialize(CheckpointIn &cp)
     std::string cache_trace_file;
     uint64_t cache_trace_size = 0;
 
+    // Checkpoints without a version use the original trace format
+    uint64_t cache_trace_version = CacheRecorder::LegacyTraceVersion;
+
     UNSERIALIZE_SCALAR(cache_trace_file);
     UNSERIALIZE_SCALAR(cache_trace_size);
+    UNSERIALIZE_OPT_SCALAR(cache_trace_version);
     cache_trace_file = cp.getCptDir() + "/" + cache_trace_file;
 
     readCompressedTrace(cache_trace_file, uncompressed_trace,
@@ -408,13 +417,29 @@ RubySystem::unserialize(CheckpointIn &cp)
     m_systems_to_warmup++;
 
     // Create the cache recorder that will hang around until startup.
-    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
+    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes,
+                      cache_trace_version);
 }
 
 void
 RubySystem::init()
 {
     registerRequestorIDs();
+
+    // Controllers on different event queues only exchange messages
+    // through the network, which is checked by MessageBuffer. The
+    // random delays and the cache warmup both assume a single thread.
+    bool multiple_queues = false;
+    for (auto cntrl : m_abs_cntrl_vec) {
+        if (cntrl->eventQueue() != eventQueue())
+            multiple_queues = true;
+    }
+    fatal_if(multiple_queues && m_randomization,
+             "Ruby randomization is not supported when the controllers "
+             "are on multiple event queues.\n");
+    fatal_if(multiple_queues && m_warmup_enabled,
+             "Ruby cache warmup is not supported when the controllers "
+             "are on multiple event queues.\n");
 }
 
 void
@@ -472,7 +497,7 @@ void
 RubySystem::processRubyEvent()
 {
     if (getWarmupEnabled()) {
-        m_cache_recorder->enqueueNextFetchRequest();
+        m_cache_recorder->startFetchRequests();
     } else if (getCooldownEnabled()) {
         m_cache_recorder->enqueueNextFlushRequest();
     }
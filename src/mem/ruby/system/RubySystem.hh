@@ -123,7 +123,9 @@ class RubySystem : public ClockedObject
 
     void makeCacheRecorder(uint8_t *uncompressed_trace,
                            uint64_t cache_trace_size,
-                           uint64_t block_size_bytes);
+                           uint64_t block_size_bytes,
+                           uint64_t trace_version =
+                               CacheRecorder::TraceVersion);
 
     static void readCompressedTrace(std::string filename,
                                     uint8_t *&raw_data,
@@ -144,6 +146,7 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_parallel_warmup;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
@@ -57,6 +57,14 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    parallel_warmup = Param.Bool(
+        False,
+        "Replay the cache contents of a checkpoint through all sequencers "
+        "at the same time instead of one request at a time. This is much "
+        "faster with many caches, but lines shared by several caches may "
+        "end up in a different, still coherent, state.",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -68,7 +68,7 @@ class DeferEnqueueingStatementAST(StatementAST):
         # Declare message
         code(
             "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge());"
+            "${{msg_type.c_ident}}::create(clockEdge());"
         )
 
         # The other statements
@@ -45,6 +45,10 @@ from slicc.symbols.Var import Var
 import slicc.generate.html as html
 import re
 
+# Number of ports for which a controller can track whether they hold
+# messages, see Consumer::MaxPendingPorts
+MAX_PENDING_PORTS = 64
+
 python_class_map = {
     "int": "Int",
     "NodeID": "Int",
@@ -242,6 +246,18 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    def getPendingPortMap(self):
+        """Map the message buffers read by in_ports to the index of their
+        pending flag in the controller, see Consumer::portPending()"""
+        pending = {}
+        for port in self.in_ports:
+            if port.pairs["buffer_type"].ident != "MessageBuffer":
+                continue
+            buf_name = f"m_{port.pairs['buffer_expr'].name}_ptr"
+            if buf_name not in pending and len(pending) < MAX_PENDING_PORTS:
+                pending[buf_name] = len(pending)
+        return pending
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
@@ -770,9 +786,15 @@ $c_ident::init()
             code("${{prefetcher.code}}.setController(this);")
 
         code()
+        pending_ports = self.getPendingPortMap()
         for port in self.in_ports:
             # Set the queue consumers
-            code("${{port.code}}.setConsumer(this);")
+            buf_name = f"m_{port.pairs['buffer_expr'].name}_ptr"
+            if buf_name in pending_ports:
+                index = pending_ports[buf_name]
+                code("${{port.code}}.setConsumer(this, $index);")
+            else:
+                code("${{port.code}}.setConsumer(this);")
 
         # Initialize the transition profiling
         code()
@@ -1397,6 +1419,7 @@ $c_ident::functionalReadBuffers(PacketPtr& pkt, WriteMask &mask)
             code('#include "${{include_path}}"')
 
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
+        pending_ports = self.getPendingPortMap()
 
         code(
             """
@@ -1438,6 +1461,12 @@ ${ident}_Controller::wakeup()
         for port in self.in_ports:
             code.indent()
             code("// ${ident}InPort $port")
+            # Skip ports whose buffer is empty
+            buf_name = f"m_{port.pairs['buffer_expr'].name}_ptr"
+            pending = buf_name in pending_ports
+            if pending:
+                code("if (portPending(${{pending_ports[buf_name]}})) {")
+                code.indent()
             if "rank" in port.pairs:
                 code('m_cur_in_port = ${{port.pairs["rank"]}};')
             else:
@@ -1456,6 +1485,9 @@ ${ident}_Controller::wakeup()
             }
 """
                 )
+            if pending:
+                code.dedent()
+                code("}")
             code.dedent()
             code("")
 
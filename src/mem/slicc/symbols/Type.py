@@ -147,6 +147,10 @@ class Type(Symbol):
     def isInterface(self):
         return "interface" in self
 
+    @property
+    def isCacheEntry(self):
+        return self.get("interface") == "AbstractCacheEntry"
+
     # Return false on error
     def addDataMember(self, ident, type, pairs, init_code):
         if ident in self.data_members:
@@ -227,12 +231,17 @@ class Type(Symbol):
 #define __${{self.c_ident}}_HH__
 
 #include <iostream>
+#include <memory>
+#include <utility>
 
 #include "mem/ruby/slicc_interface/RubySlicc_Util.hh"
 
 """
         )
 
+        if self.isMessage or self.isCacheEntry:
+            code('#include "base/pool_alloc.hh"')
+
         for dm in self.data_members.values():
             if not dm.type.isPrimitive:
                 code('#include "mem/ruby/protocol/$0.hh"', dm.type.c_ident)
@@ -319,14 +328,26 @@ $klass ${{self.c_ident}}$parent
             code.dedent()
             code("}")
 
-        # create a clone member
+        # create a factory and a clone member
         if self.isMessage:
             code(
                 """
+/**
+ * Allocate a message and its reference count from a per-thread pool
+ * rather than the heap. Takes the same arguments as the constructors.
+ */
+template <typename... Args>
+static std::shared_ptr<${{self.c_ident}}>
+create(Args&&... args)
+{
+    return std::allocate_shared<${{self.c_ident}}>(
+        PoolAllocator<${{self.c_ident}}>(), std::forward<Args>(args)...);
+}
+
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return create(*this);
 }
 """
             )
@@ -338,6 +359,29 @@ clone() const
 {
      return new ${{self.c_ident}}(*this);
 }
+"""
+            )
+
+        # Cache entries are allocated and freed on every fill and
+        # eviction. Take them from a pool so that the entries of a cache
+        # are packed in slabs rather than scattered over the heap.
+        if self.isCacheEntry:
+            code(
+                """
+static void *
+operator new(size_t size)
+{
+    assert(size == sizeof(${{self.c_ident}}));
+    return pool_alloc::FixedSizePool<sizeof(${{self.c_ident}}),
+        alignof(${{self.c_ident}})>::allocate();
+}
+
+static void
+operator delete(void *ptr)
+{
+    pool_alloc::FixedSizePool<sizeof(${{self.c_ident}}),
+        alignof(${{self.c_ident}})>::deallocate(ptr);
+}
 """
             )
 
@@ -34,6 +34,7 @@ class MemMode(Enum):
     TIMING = 1
     ATOMIC = 2
     ATOMIC_NONCACHING = 3
+    ATOMIC_WARMING = 4
 
 
 def mem_mode_to_string(mem_mode: MemMode) -> str:
@@ -49,5 +50,7 @@ def mem_mode_to_string(mem_mode: MemMode) -> str:
         return "atomic"
     elif mem_mode == MemMode.ATOMIC_NONCACHING:
         return "atomic_noncaching"
+    elif mem_mode == MemMode.ATOMIC_WARMING:
+        return "atomic_warming"
     else:
         return NotImplementedError
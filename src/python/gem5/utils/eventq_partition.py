@@ -0,0 +1,255 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Helpers to split a system over multiple event queues.
+
+Multi-eventq simulation requires every SimObject to be bound to an event
+queue via its `eventq_index` parameter and the Root to be given a
+`sim_quantum`. Doing this by hand is tedious and error prone. The
+functions in this module derive a partition automatically: each core
+forms one partition together with every object that is only reachable
+from that core when following request ports downstream (e.g., its
+private L1 and L2 caches and page table walkers). Everything that is
+reachable from more than one core stays on the shared event queue.
+
+The latency of the objects at the partition boundary (typically the
+crossbar connecting the private caches to the shared levels) bounds how
+far ahead a partition may run, which gives a safe value for
+`sim_quantum`.
+
+Note that partitions may only interact through mechanisms that are safe
+across threads, such as the ThreadBridge, KVM cores or atomic accesses
+using memory backdoors.
+
+Ruby systems using the simple network can instead be partitioned by
+router with `partition_ruby`. Messages then only cross partitions on
+the internal links of the network, whose latency gives the quantum.
+Garnet is not supported since its links are not safe across threads.
+"""
+
+from typing import Iterable, List, Optional
+
+from m5.SimObject import SimObject
+from m5.params import VectorPortRef
+from m5.proxy import isproxy
+
+
+def _downstream(obj: SimObject) -> Iterable[SimObject]:
+    """Yield the objects connected to the request ports of `obj`."""
+    for port in obj._port_refs.values():
+        refs = port.elements if isinstance(port, VectorPortRef) else [port]
+        for ref in refs:
+            if ref.is_source and ref.peer and not isproxy(ref.peer):
+                yield ref.peer.simobj
+
+
+def _clock_period(obj: SimObject) -> Optional[int]:
+    """Clock period of `obj` in ticks or None if it can't be resolved."""
+    try:
+        domain = obj.clk_domain
+        if isproxy(domain):
+            domain = domain.unproxy(obj)
+        divider = 1
+        while hasattr(domain, "clk_divider"):
+            divider *= int(domain.clk_divider)
+            parent = domain.clk_domain
+            domain = parent.unproxy(domain) if isproxy(parent) else parent
+        return domain.clock[0].getValue() * divider
+    except Exception:
+        return None
+
+
+def partition_event_queues(
+    cores: List[SimObject], first_eventq: int = 1
+) -> List[List[SimObject]]:
+    """
+    Bind each core, and the objects private to it, to its own event queue.
+
+    :param cores: The core SimObjects. Core `i` is bound to event queue
+                  `first_eventq + i`.
+    :param first_eventq: Index of the event queue used by the first core.
+                         Shared objects keep their current binding, which
+                         is event queue 0 unless configured otherwise.
+
+    :returns: The objects in each partition, in core order.
+    """
+    owners = {}
+    objects = {}
+    for i, core in enumerate(cores):
+        seen = set()
+        stack = list(core.descendants())
+        while stack:
+            obj = stack.pop()
+            if id(obj) in seen:
+                continue
+            seen.add(id(obj))
+            objects[id(obj)] = obj
+            owners.setdefault(id(obj), set()).add(i)
+            stack.extend(_downstream(obj))
+
+    clusters = [[] for _ in cores]
+    for key, obj_owners in owners.items():
+        if len(obj_owners) == 1:
+            clusters[next(iter(obj_owners))].append(objects[key])
+
+    for i, cluster in enumerate(clusters):
+        for obj in cluster:
+            obj.eventq_index = first_eventq + i
+
+    return clusters
+
+
+def partition_lookahead(clusters: List[List[SimObject]]) -> Optional[int]:
+    """
+    Compute a safe simulation quantum for a set of partitions.
+
+    The quantum is the smallest request latency, in ticks, of any shared
+    object directly downstream of a partition. Only objects with a
+    `frontend_latency` and `forward_latency` (i.e., crossbars) are
+    considered since those are the objects that decouple partitions.
+
+    :param clusters: The partitions as returned by `partition_event_queues`.
+
+    :returns: The lookahead in ticks, or None if no boundary latency could
+              be determined. Requires the global frequency to be fixed.
+    """
+    private = {id(obj) for cluster in clusters for obj in cluster}
+    lookahead = None
+    for cluster in clusters:
+        for obj in cluster:
+            for peer in _downstream(obj):
+                if id(peer) in private:
+                    continue
+                if not hasattr(peer, "frontend_latency") or not hasattr(
+                    peer, "forward_latency"
+                ):
+                    continue
+                period = _clock_period(peer)
+                if period is None:
+                    continue
+                cycles = int(peer.frontend_latency) + int(peer.forward_latency)
+                ticks = cycles * period
+                if ticks > 0 and (lookahead is None or ticks < lookahead):
+                    lookahead = ticks
+
+    return lookahead
+
+
+def _ruby_ports(cntrl: SimObject) -> Iterable[SimObject]:
+    """Yield the RubyPorts (e.g., sequencers) used by a controller."""
+    for value in cntrl._values.values():
+        if isinstance(value, SimObject) and hasattr(value, "in_ports"):
+            yield value
+
+
+def _upstream(obj: SimObject) -> Iterable[SimObject]:
+    """Yield the objects connected to the response ports of `obj`."""
+    for port in obj._port_refs.values():
+        refs = port.elements if isinstance(port, VectorPortRef) else [port]
+        for ref in refs:
+            if not ref.is_source and ref.peer and not isproxy(ref.peer):
+                yield ref.peer.simobj
+
+
+def partition_ruby(
+    network: SimObject, first_eventq: int = 0
+) -> List[List[SimObject]]:
+    """
+    Bind each router of a simple Ruby network, and the controllers
+    attached to it, to its own event queue.
+
+    A partition holds a router, the controllers on its external links,
+    their sequencers and the cores using them, and every object that is
+    only reachable from these when following request ports downstream
+    (e.g., memory controllers). Objects reachable from several routers
+    keep their current binding.
+
+    :param network: The SimpleNetwork. Garnet networks are not supported.
+    :param first_eventq: Index of the event queue used by the first
+                         router.
+
+    :returns: The objects in each partition, in router order.
+    """
+    if not hasattr(network, "endpoint_bandwidth"):
+        raise TypeError("Only the simple network can be partitioned")
+
+    routers = list(network.routers)
+    index = {id(router): i for i, router in enumerate(routers)}
+    roots = [[router] for router in routers]
+    for link in network.ext_links:
+        cntrl = link.ext_node
+        root = roots[index[id(link.int_node)]]
+        root.append(cntrl)
+        for port in _ruby_ports(cntrl):
+            root.append(port)
+            root.extend(_upstream(port))
+
+    owners = {}
+    objects = {}
+    for i, root in enumerate(roots):
+        seen = set()
+        stack = [d for obj in root for d in obj.descendants()]
+        while stack:
+            obj = stack.pop()
+            if id(obj) in seen:
+                continue
+            seen.add(id(obj))
+            objects[id(obj)] = obj
+            owners.setdefault(id(obj), set()).add(i)
+            stack.extend(_downstream(obj))
+
+    clusters = [[] for _ in routers]
+    for key, obj_owners in owners.items():
+        if len(obj_owners) == 1:
+            clusters[next(iter(obj_owners))].append(objects[key])
+
+    for i, cluster in enumerate(clusters):
+        for obj in cluster:
+            obj.eventq_index = first_eventq + i
+
+    return clusters
+
+
+def ruby_lookahead(network: SimObject) -> Optional[int]:
+    """
+    Compute a safe simulation quantum for a partitioned Ruby network.
+
+    :param network: The network partitioned by `partition_ruby`.
+
+    :returns: The smallest latency, in ticks, of any internal link or
+              None if it could not be determined.
+    """
+    lookahead = None
+    for link in network.int_links:
+        period = _clock_period(link.src_node)
+        if period is None:
+            continue
+        ticks = int(link.latency) * period
+        if ticks > 0 and (lookahead is None or ticks < lookahead):
+            lookahead = ticks
+
+    return lookahead
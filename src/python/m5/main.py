@@ -282,6 +282,15 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-format",
+        metavar="{text,binary}",
+        choices=["text", "binary"],
+        default="text",
+        help="Sets the format of the debug output. Binary output is "
+        "written without formatting the messages and can be decoded with "
+        "util/decode_binary_trace.py [Default: %default]",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -582,7 +591,10 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_format == "binary":
+        trace.outputBinary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
@@ -403,6 +403,10 @@ def switchCpus(system, cpuList, verbose=True):
         if memory_mode == MemoryMode("atomic_noncaching").getValue():
             memWriteback(system)
             memInvalidate(system)
+        elif memory_mode == MemoryMode("atomic_warming").getValue():
+            # Caches that are being warmed expect memory to hold the
+            # latest data, but they can keep their clean copies.
+            memWriteback(system)
 
         _changeMemoryMode(system, memory_mode)
 
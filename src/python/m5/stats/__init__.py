@@ -186,6 +186,31 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["columnar"])
+def _columnarFactory(fn, compress=True, desc=True, formulas=True):
+    """Output stats in a binary columnar format.
+
+    The names of the stats are written once, every dump then appends a
+    row holding one double per stat. This makes periodic stat dumps
+    cheap to write and fast to load for time-series analysis. The
+    files can be read using m5.stats.columnar.
+
+    Known limitations:
+      * Only the number of samples of sparse histograms is stored.
+
+    Parameters:
+      * compress (bool): Compress the rows (default: True)
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+
+    Example:
+      columnar://stats.gcs?desc=False;formulas=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, compress, desc, formulas)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -355,12 +380,8 @@ def prepare():
 def _dump_to_visitor(visitor, roots=None):
     # New stats
     def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
+        # The groups are walked in C++, which only knows the C++ objects
+        _m5.stats.visitGroup(visitor, group.getCCObject())
 
     if roots:
         # New stats from selected subroots.
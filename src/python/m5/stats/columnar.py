@@ -0,0 +1,199 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader for binary columnar stat files.
+
+These files are written by the `columnar://` stats output and hold one
+row of values per stat dump. See src/base/stats/columnar.hh for a
+description of the format.
+
+This module only depends on the Python standard library so that it can
+be used outside of gem5, e.g.:
+
+    from columnar import ColumnarStats
+
+    stats = ColumnarStats("m5out/stats.gcs")
+    ipc = stats["system.cpu.ipc"]
+    for tick, value in zip(stats.ticks, ipc):
+        print(tick, value)
+
+If numpy is available, `ColumnarStats.array()` returns the values of a
+stat as a numpy array.
+"""
+
+import struct
+import zlib
+from typing import (
+    Dict,
+    Iterator,
+    List,
+    Tuple,
+)
+
+MAGIC = b"gem5cols"
+VERSION = 1
+FLAG_COMPRESSED = 0x1
+
+SCHEMA_RECORD = ord("S")
+ROW_RECORD = ord("R")
+COMPRESSED_ROW_RECORD = ord("Z")
+
+
+class Segment:
+    """A schema together with the rows written using it."""
+
+    def __init__(self, names: List[str], descs: List[str]):
+        self.names = names
+        self.descs = descs
+        self.index = {name: i for i, name in enumerate(names)}
+        self.ticks = []
+        self.rows = []
+
+
+def _parse_schema(payload: bytes) -> Segment:
+    (count,) = struct.unpack_from("<I", payload, 0)
+    pos = 4
+    names = []
+    descs = []
+    for _ in range(count):
+        strings = []
+        for _ in range(2):
+            (length,) = struct.unpack_from("<H", payload, pos)
+            pos += 2
+            strings.append(payload[pos : pos + length].decode())
+            pos += length
+        names.append(strings[0])
+        descs.append(strings[1])
+    return Segment(names, descs)
+
+
+def _records(data: bytes) -> Iterator[Tuple[int, bytes]]:
+    if data[:8] != MAGIC:
+        raise ValueError("Not a gem5 columnar stats file")
+    version, _ = struct.unpack_from("<II", data, 8)
+    if version != VERSION:
+        raise ValueError(f"Unsupported columnar stats version {version}")
+
+    pos = 16
+    while pos + 5 <= len(data):
+        kind, size = struct.unpack_from("<BI", data, pos)
+        pos += 5
+        if pos + size > len(data):
+            # Truncated record, e.g., the simulation is still running
+            break
+        yield kind, data[pos : pos + size]
+        pos += size
+
+
+class ColumnarStats:
+    """
+    All dumps in a columnar stat file.
+
+    A file may contain multiple schemas if the set of stats changed
+    during the simulation. Stats are looked up by name over all dumps,
+    with None for dumps that did not contain the stat.
+    """
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            data = f.read()
+
+        self.segments = []
+        segment = None
+        last = None
+        for kind, payload in _records(data):
+            if kind == SCHEMA_RECORD:
+                segment = _parse_schema(payload)
+                self.segments.append(segment)
+                last = [0] * len(segment.names)
+            elif kind == ROW_RECORD:
+                count = len(segment.names)
+                tick, *values = struct.unpack(f"<Q{count}d", payload)
+                segment.ticks.append(tick)
+                segment.rows.append(values)
+            elif kind == COMPRESSED_ROW_RECORD:
+                count = len(segment.names)
+                raw = zlib.decompress(payload)
+                tick, *words = struct.unpack(f"<Q{count}Q", raw)
+                last = [w ^ l for w, l in zip(words, last)]
+                segment.ticks.append(tick)
+                packed = struct.pack(f"<{count}Q", *last)
+                segment.rows.append(list(struct.unpack(f"<{count}d", packed)))
+            else:
+                raise ValueError(f"Unknown record kind {kind}")
+
+    @property
+    def ticks(self) -> List[int]:
+        """The tick of every dump."""
+        return [t for s in self.segments for t in s.ticks]
+
+    @property
+    def names(self) -> List[str]:
+        """The names of all stats, in the order they first appeared."""
+        names = {}
+        for segment in self.segments:
+            names.update(dict.fromkeys(segment.names))
+        return list(names)
+
+    def description(self, name: str) -> str:
+        for segment in self.segments:
+            if name in segment.index:
+                return segment.descs[segment.index[name]]
+        raise KeyError(name)
+
+    def __contains__(self, name: str) -> bool:
+        return any(name in s.index for s in self.segments)
+
+    def __getitem__(self, name: str) -> List[float]:
+        if name not in self:
+            raise KeyError(name)
+        values = []
+        for segment in self.segments:
+            i = segment.index.get(name)
+            values.extend(
+                row[i] if i is not None else None for row in segment.rows
+            )
+        return values
+
+    def __len__(self) -> int:
+        return sum(len(s.rows) for s in self.segments)
+
+    def dump(self, index: int) -> Dict[str, float]:
+        """All values of a single dump."""
+        for segment in self.segments:
+            if index < len(segment.rows):
+                return dict(zip(segment.names, segment.rows[index]))
+            index -= len(segment.rows)
+        raise IndexError(index)
+
+    def array(self, name: str):
+        """The values of a stat as a numpy array, NaN where missing."""
+        import numpy
+
+        return numpy.array(
+            [float("nan") if v is None else v for v in self[name]]
+        )
@@ -25,4 +25,11 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 # Export native methods to Python
-from _m5.trace import output, activate, ignore, disable, enable
+from _m5.trace import (
+    output,
+    outputBinary,
+    activate,
+    ignore,
+    disable,
+    enable,
+)
@@ -42,13 +42,16 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <cstring>
 #include <map>
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +70,18 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    fatal_if(!strcmp(filename, "cout") || !strcmp(filename, "cerr"),
+             "Binary debug output needs a file, e.g., "
+             "--debug-file=trace.bin\n");
+
+    auto *logger = new trace::BinaryLogger(simout.resolve(filename));
+    trace::setDebugLogger(logger);
+    registerExitCallback([logger]() { logger->close(); });
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +144,7 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -86,6 +87,24 @@ cast_stat_info(const statistics::Info *info)
 namespace statistics
 {
 
+/**
+ * Visit all stats of a group and its sub-groups. This is equivalent to
+ * walking the groups in Python, but avoids the cost of creating a
+ * Python object for every stat on every dump.
+ */
+static void
+visitGroup(Output &output, const Group &group)
+{
+    for (auto *info : group.getStats())
+        info->visit(output);
+
+    for (const auto &g : group.getStatGroups()) {
+        output.beginGroup(g.first.c_str());
+        visitGroup(output, *g.second);
+        output.endGroup();
+    }
+}
+
 void
 pythonDump()
 {
@@ -114,6 +133,8 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initColumnar", &statistics::initColumnar)
+        .def("visitGroup", &statistics::visitGroup)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
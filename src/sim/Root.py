@@ -31,6 +31,10 @@ from m5.params import *
 from m5.util import fatal
 
 
+class EventQueueBackend(Enum):
+    vals = ["sorted_list", "calendar"]
+
+
 class Root(SimObject):
 
     _the_instance = None
@@ -67,6 +71,17 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    sim_quantum_adaptive = Param.Bool(
+        False,
+        "Skip synchronization quanta in which no event queue has pending "
+        "events",
+    )
+
+    # Data structure used to hold pending events on the main event
+    # queues. Both backends service events in the same order.
+    eventq_backend = Param.EventQueueBackend(
+        "sorted_list", "Event queue implementation"
+    )
 
     full_system = Param.Bool("if this is a full system simulation")
 
@@ -47,7 +47,17 @@ from m5.objects.Workload import StubWorkload
 
 
 class MemoryMode(Enum):
-    vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
+    vals = [
+        "invalid",
+        "atomic",
+        "timing",
+        "atomic_noncaching",
+        "atomic_warming",
+    ]
+
+
+class MemoryCheckpointFormat(ScopedEnum):
+    vals = ["gzip", "pages", "chunked", "raw"]
 
 
 class System(SimObject):
@@ -105,6 +115,27 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Format used to store the backing store in checkpoints. 'gzip'
+    # writes a single compressed image. 'pages' writes deduplicated,
+    # uncompressed pages with zero pages elided; pages that did not
+    # change since the last checkpoint written or restored by this
+    # simulation refer to that checkpoint instead, and restoring maps
+    # the pages lazily from the checkpoint. 'chunked' compresses
+    # independent chunks of memory in parallel, using zstd if gem5 was
+    # built with it and zlib otherwise. 'raw' writes an uncompressed
+    # sparse image that is mapped copy-on-write as the backing store
+    # when restoring, so that memory is only read when it is touched
+    # and is shared between simulations restored from the same
+    # checkpoint.
+    memory_checkpoint_format = Param.MemoryCheckpointFormat(
+        "gzip", "Format of the memory image in checkpoints"
+    )
+    memory_checkpoint_threads = Param.Unsigned(
+        0,
+        "Number of host threads used to compress and decompress chunked "
+        "memory images, 0 to use all host cores",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -30,6 +30,7 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
@@ -46,6 +47,7 @@ namespace gem5
 {
 
 Tick simQuantum = 0;
+bool simQuantumAdaptive = false;
 
 //
 // Main Event Queues
@@ -58,6 +60,9 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+static EventQueue::Backend mainEventQueueBackend =
+    EventQueue::Backend::SortedList;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -65,11 +70,20 @@ getEventQueue(uint32_t index)
         numMainEventQueues++;
         mainEventQueue.push_back(
             new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.back()->setBackend(mainEventQueueBackend);
     }
 
     return mainEventQueue[index];
 }
 
+void
+setMainEventQueueBackend(EventQueue::Backend backend)
+{
+    mainEventQueueBackend = backend;
+    for (auto *eq : mainEventQueue)
+        eq->setBackend(backend);
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -137,6 +151,11 @@ Event::releaseImpl()
 void
 EventQueue::insert(Event *event)
 {
+    if (_backend == Backend::Calendar) {
+        calInsert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -196,6 +215,11 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (_backend == Backend::Calendar) {
+        calRemove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -220,6 +244,189 @@ EventQueue::remove(Event *event)
     prev->nextBin = Event::removeItem(event, curr);
 }
 
+void
+EventQueue::calInsert(Event *event)
+{
+    // Find the bin in the event's bucket, exactly like insert() does
+    // for the whole queue.
+    Event **bucket = &calBuckets[calBucket(event->when())];
+    Event *prev = nullptr;
+    Event *curr = *bucket;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+    }
+
+    const bool new_bin = !curr || *event < *curr;
+    Event *top = Event::insertBefore(event, curr);
+    if (prev)
+        prev->nextBin = top;
+    else
+        *bucket = top;
+
+    // The inserted event is always on top of its bin
+    if (!head || *event <= *head)
+        head = event;
+
+    if (new_bin && ++calBins > 2 * calBuckets.size())
+        calResize(2 * calBuckets.size());
+}
+
+void
+EventQueue::calRemove(Event *event)
+{
+    Event **bucket = &calBuckets[calBucket(event->when())];
+    Event *prev = nullptr;
+    Event *curr = *bucket;
+    while (curr && *curr < *event) {
+        prev = curr;
+        curr = curr->nextBin;
+    }
+
+    if (!curr || *curr != *event)
+        panic("event not found!");
+
+    const bool bin_removed = event == curr && !curr->nextInBin;
+    Event *top = Event::removeItem(event, curr);
+    if (prev)
+        prev->nextBin = top;
+    else
+        *bucket = top;
+
+    if (!bin_removed) {
+        // Either the head is unaffected or the next event in its bin
+        // takes over.
+        if (event == head)
+            head = top;
+        return;
+    }
+
+    --calBins;
+    if (event == head)
+        head = calFindHead(event->when());
+
+    if (calBuckets.size() > MinCalendarBuckets &&
+        calBins < calBuckets.size() / 2) {
+        calResize(calBuckets.size() / 2);
+    }
+}
+
+Event *
+EventQueue::calFindHead(Tick from) const
+{
+    // All pending events are at or after 'from'. Walk one calendar
+    // year starting at the bucket of 'from'; the first bucket whose
+    // earliest bin falls in the window currently covered by that bucket
+    // holds the earliest event.
+    const size_t num_buckets = calBuckets.size();
+    const Tick from_window = from / calWidth;
+    size_t idx = calBucket(from);
+    for (size_t i = 0; i < num_buckets; ++i) {
+        Event *bin = calBuckets[idx];
+        if (bin && bin->when() / calWidth - from_window == i)
+            return bin;
+        idx = (idx + 1) & (num_buckets - 1);
+    }
+
+    // Nothing within a year, fall back to a direct search
+    Event *earliest = nullptr;
+    for (auto *bin : calBuckets) {
+        if (bin && (!earliest || *bin < *earliest))
+            earliest = bin;
+    }
+    return earliest;
+}
+
+void
+EventQueue::calResize(size_t num_buckets)
+{
+    std::vector<Event *> bins;
+    bins.reserve(calBins);
+    for (auto *bin : calBuckets) {
+        for (; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    // Estimate the bucket width from the separation of the earliest
+    // bins, which are the ones that will be dequeued next.
+    const size_t samples = std::min<size_t>(bins.size(), 32);
+    if (samples > 1) {
+        std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                          [](const Event *l, const Event *r)
+                          { return *l < *r; });
+        const Tick span = bins[samples - 1]->when() - bins[0]->when();
+        calWidth = std::max<Tick>(1, 3 * (span / (samples - 1)));
+    }
+
+    calBuckets.assign(num_buckets, nullptr);
+
+    // Bins keep their 'in bin' stacks, only the bin list is rebuilt.
+    // Inserting in reverse order keeps most insertions at the front
+    // of their bucket.
+    std::sort(bins.begin(), bins.end(),
+              [](const Event *l, const Event *r) { return *l < *r; });
+    for (auto it = bins.rbegin(); it != bins.rend(); ++it) {
+        Event **bucket = &calBuckets[calBucket((*it)->when())];
+        Event *prev = nullptr;
+        Event *curr = *bucket;
+        while (curr && *curr < **it) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        (*it)->nextBin = curr;
+        if (prev)
+            prev->nextBin = *it;
+        else
+            *bucket = *it;
+    }
+}
+
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    std::vector<Event *> bins;
+    if (_backend == Backend::Calendar) {
+        bins.reserve(calBins);
+        for (auto *bin : calBuckets) {
+            for (; bin; bin = bin->nextBin)
+                bins.push_back(bin);
+        }
+        std::sort(bins.begin(), bins.end(),
+                  [](const Event *l, const Event *r) { return *l < *r; });
+    } else {
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+    return bins;
+}
+
+void
+EventQueue::setBackend(Backend backend)
+{
+    if (backend == _backend)
+        return;
+
+    // Collect the pending events in service order
+    std::vector<Event *> events;
+    for (auto *bin : sortedBins()) {
+        for (Event *event = bin; event; event = event->nextInBin)
+            events.push_back(event);
+    }
+
+    head = nullptr;
+    _backend = backend;
+    calBins = 0;
+    if (backend == Backend::Calendar)
+        calBuckets.assign(MinCalendarBuckets, nullptr);
+    else
+        calBuckets.clear();
+
+    // Events in a bin are serviced in LIFO order, so inserting in
+    // reverse service order restores the original order.
+    for (auto it = events.rbegin(); it != events.rend(); ++it)
+        insert(*it);
+}
+
 Event *
 EventQueue::serviceOne()
 {
@@ -228,7 +435,9 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (_backend == Backend::Calendar) {
+        calRemove(event);
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -321,15 +530,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (auto *nextBin : sortedBins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -344,8 +550,7 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (auto *nextBin : sortedBins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,8 +576,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -381,6 +584,33 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (_backend == Backend::Calendar) {
+        // Hand out the pending events as a sorted list of bins, which
+        // is what the sorted list backend returns, and adopt the new
+        // events from the same form.
+        std::vector<Event *> bins = sortedBins();
+        for (size_t i = 0; i + 1 < bins.size(); ++i)
+            bins[i]->nextBin = bins[i + 1];
+        if (!bins.empty())
+            bins.back()->nextBin = nullptr;
+        Event* t = bins.empty() ? nullptr : bins.front();
+
+        size_t num_bins = 0;
+        for (Event *bin = s; bin; bin = bin->nextBin)
+            ++num_bins;
+        size_t num_buckets = MinCalendarBuckets;
+        while (2 * num_buckets < num_bins)
+            num_buckets *= 2;
+
+        // calResize() redistributes all bins, wherever they are
+        calBuckets.assign(MinCalendarBuckets, nullptr);
+        calBuckets[0] = s;
+        calBins = num_bins;
+        calResize(num_buckets);
+        head = s;
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
@@ -442,7 +672,8 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), _backend(Backend::SortedList),
+      calWidth(1), calBins(0)
 {
 }
 
@@ -468,4 +699,17 @@ EventQueue::handleAsyncInsertions()
     async_queue_mutex.unlock();
 }
 
+Tick
+EventQueue::nextPendingTick()
+{
+    Tick next = empty() ? MaxTick : nextTick();
+
+    async_queue_mutex.lock();
+    for (const auto *event : async_queue)
+        next = std::min(next, event->when());
+    async_queue_mutex.unlock();
+
+    return next;
+}
+
 } // namespace gem5
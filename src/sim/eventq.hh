@@ -43,6 +43,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -68,6 +69,12 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Adaptive quantum for multiple eventq simulation. When set, the
+//! global synchronization event skips over stretches of simulated time
+//! in which no queue has any pending events instead of synchronizing
+//! every simQuantum ticks.
+extern bool simQuantumAdaptive;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -614,6 +621,20 @@ operator!=(const Event &l, const Event &r)
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure used to keep the pending events in order. Both
+     * backends service events in exactly the same (when, priority,
+     * LIFO within a bin) order and can be switched at any time.
+     */
+    enum class Backend
+    {
+        /** Sorted list of bins, linear time insertion. */
+        SortedList,
+        /** Calendar queue of bins, amortized constant time insertion. */
+        Calendar,
+    };
+
   private:
     friend void curEventQueue(EventQueue *);
 
@@ -621,6 +642,36 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
+    Backend _backend;
+
+    /**
+     * Calendar queue state, only used by the Calendar backend. Each
+     * bucket holds a sorted list of bins (linked through nextBin) for
+     * the events whose (when / calWidth) maps to it. The head pointer
+     * is kept pointing to the top of the earliest bin in the calendar.
+     * @{
+     */
+    std::vector<Event *> calBuckets;
+    Tick calWidth;
+    size_t calBins;
+
+    static constexpr size_t MinCalendarBuckets = 16;
+
+    size_t
+    calBucket(Tick when) const
+    {
+        return (when / calWidth) & (calBuckets.size() - 1);
+    }
+
+    void calInsert(Event *event);
+    void calRemove(Event *event);
+    Event *calFindHead(Tick from) const;
+    void calResize(size_t num_buckets);
+    /** @} */
+
+    /** Tops of all bins, sorted in service order. */
+    std::vector<Event *> sortedBins() const;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
@@ -748,6 +799,15 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Switch the data structure holding the pending events. Events that
+     * are already scheduled are moved over without changing the order
+     * in which they will be serviced. Should only be called by the
+     * thread operating this queue.
+     */
+    void setBackend(Backend backend);
+    Backend backend() const { return _backend; }
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -905,6 +965,16 @@ class EventQueue
      */
     void handleAsyncInsertions();
 
+    /**
+     * Earliest tick of any event pending on this queue, including
+     * events that are still waiting in the async queue. Only safe to
+     * call while the thread owning this queue is parked, e.g., inside
+     * a global barrier.
+     *
+     * @return The earliest pending tick or MaxTick if there is none.
+     */
+    Tick nextPendingTick();
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -977,6 +1047,9 @@ curEventQueue(EventQueue *q)
 
 void dumpMainQueue();
 
+//! Backend used by main event queues, including the ones created later.
+void setMainEventQueueBackend(EventQueue::Backend backend);
+
 class EventManager
 {
   protected:
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event that records its id when it is processed. */
+class RecordEvent : public Event
+{
+  public:
+    RecordEvent(int _id, std::vector<int> &_log, Priority p)
+        : Event(p), id(_id), log(_log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+    const int id;
+
+  private:
+    std::vector<int> &log;
+};
+
+/**
+ * Run a reproducible mix of schedule, deschedule, reschedule and
+ * serviceOne operations on a queue and return the order in which events
+ * were processed.
+ */
+std::vector<int>
+runMix(EventQueue::Backend backend, unsigned seed, int num_events,
+       int num_ops, bool switch_backend=false)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.setBackend(backend);
+    EventQueue *prev_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    std::mt19937 rng(seed);
+    const Event::Priority prios[] = {
+        Event::Minimum_Pri, Event::Default_Pri, Event::CPU_Tick_Pri };
+
+    std::vector<std::unique_ptr<RecordEvent>> events;
+    for (int i = 0; i < num_events; ++i) {
+        events.emplace_back(new RecordEvent(i, log, prios[rng() % 3]));
+    }
+
+    for (int op = 0; op < num_ops; ++op) {
+        if (switch_backend && op == num_ops / 2) {
+            eq.setBackend(backend == EventQueue::Backend::Calendar ?
+                          EventQueue::Backend::SortedList :
+                          EventQueue::Backend::Calendar);
+        }
+
+        auto &event = events[rng() % num_events];
+        // Coarse delays make many events share a bin
+        const Tick when = eq.getCurTick() + (rng() % 64) * 250;
+        switch (rng() % 4) {
+          case 0:
+          case 1:
+            if (!event->scheduled())
+                eq.schedule(event.get(), when);
+            break;
+          case 2:
+            if (event->scheduled())
+                eq.deschedule(event.get());
+            else
+                eq.reschedule(event.get(), when, true);
+            break;
+          case 3:
+            if (!eq.empty())
+                eq.serviceOne();
+            break;
+        }
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    curEventQueue(prev_eq);
+    return log;
+}
+
+/**
+ * A hold-model workload, where every serviced event is replaced by a
+ * new one and a fraction of the events are descheduled and scheduled
+ * again, keeps many events pending and resizes the calendar often.
+ */
+std::vector<int>
+runHoldModel(EventQueue::Backend backend)
+{
+    const int pending = 4096;
+    const int ops = 20000;
+
+    std::vector<int> log;
+    EventQueue eq("hold");
+    eq.setBackend(backend);
+    EventQueue *prev_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    std::mt19937 rng(0);
+    std::vector<std::unique_ptr<RecordEvent>> events;
+    for (int i = 0; i < pending; ++i) {
+        events.emplace_back(new RecordEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), rng() % 100000);
+    }
+
+    for (int op = 0; op < ops; ++op) {
+        auto &victim = events[rng() % pending];
+        eq.deschedule(victim.get());
+        eq.schedule(victim.get(), eq.getCurTick() + rng() % 100000);
+
+        eq.serviceOne();
+        auto &event = events[log.back()];
+        eq.schedule(event.get(), eq.getCurTick() + rng() % 100000);
+    }
+
+    while (!eq.empty())
+        eq.deschedule(eq.getHead());
+    curEventQueue(prev_eq);
+    return log;
+}
+
+/**
+ * Replacing the head sets the pending events aside, as done by the Ruby
+ * cache warmup, and restoring it brings them back in the same order.
+ */
+std::vector<int>
+runReplaceHead(EventQueue::Backend backend)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.setBackend(backend);
+    EventQueue *prev_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    std::vector<std::unique_ptr<RecordEvent>> events;
+    for (int i = 0; i < 64; ++i) {
+        events.emplace_back(new RecordEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), 1000 + (i % 8) * 100);
+    }
+
+    Event *saved = eq.replaceHead(nullptr);
+    EXPECT_TRUE(eq.empty());
+
+    // Run a different set of events in the meantime
+    for (int i = 64; i < 96; ++i) {
+        events.emplace_back(new RecordEvent(i, log, Event::Default_Pri));
+        eq.schedule(events.back().get(), 10 + i * 7);
+    }
+    while (!eq.empty())
+        eq.serviceOne();
+
+    EXPECT_EQ(eq.replaceHead(saved), nullptr);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    curEventQueue(prev_eq);
+    return log;
+}
+
+} // anonymous namespace
+
+/** Both backends service events in the same order. */
+TEST(EventQueueTest, CalendarMatchesSortedList)
+{
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        auto expected = runMix(EventQueue::Backend::SortedList, seed,
+                               512, 20000);
+        auto calendar = runMix(EventQueue::Backend::Calendar, seed,
+                               512, 20000);
+        ASSERT_FALSE(expected.empty());
+        ASSERT_EQ(expected, calendar) << "seed " << seed;
+    }
+}
+
+/** Switching backends with pending events does not change the order. */
+TEST(EventQueueTest, SwitchBackend)
+{
+    auto expected = runMix(EventQueue::Backend::SortedList, 42, 512, 20000);
+    ASSERT_EQ(expected,
+              runMix(EventQueue::Backend::SortedList, 42, 512, 20000, true));
+    ASSERT_EQ(expected,
+              runMix(EventQueue::Backend::Calendar, 42, 512, 20000, true));
+}
+
+/** Events in the same bin are serviced in LIFO order. */
+TEST(EventQueueTest, CalendarBinOrder)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.setBackend(EventQueue::Backend::Calendar);
+    EventQueue *prev_eq = curEventQueue();
+    curEventQueue(&eq);
+
+    RecordEvent a(0, log, Event::Default_Pri);
+    RecordEvent b(1, log, Event::Default_Pri);
+    RecordEvent c(2, log, Event::Minimum_Pri);
+    eq.schedule(&a, 100);
+    eq.schedule(&b, 100);
+    eq.schedule(&c, 100);
+    while (!eq.empty())
+        eq.serviceOne();
+
+    curEventQueue(prev_eq);
+    ASSERT_EQ(log, (std::vector<int>{2, 1, 0}));
+}
+
+/** Both backends agree on a hold-model workload. */
+TEST(EventQueueTest, HoldModel)
+{
+    auto expected = runHoldModel(EventQueue::Backend::SortedList);
+    ASSERT_EQ(expected.size(), 20000u);
+    ASSERT_EQ(expected, runHoldModel(EventQueue::Backend::Calendar));
+}
+
+/** Pending events survive replacing the head with either backend. */
+TEST(EventQueueTest, ReplaceHead)
+{
+    auto expected = runReplaceHead(EventQueue::Backend::SortedList);
+    ASSERT_EQ(expected.size(), 96u);
+    ASSERT_EQ(expected, runReplaceHead(EventQueue::Backend::Calendar));
+}
@@ -29,6 +29,8 @@
 
 #include "sim/global_event.hh"
 
+#include <algorithm>
+
 #include "sim/cur_tick.hh"
 
 namespace gem5
@@ -157,9 +159,27 @@ GlobalSyncEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::process()
 {
-    if (repeat) {
-        schedule(curTick() + repeat);
+    if (!repeat)
+        return;
+
+    Tick next = curTick() + repeat;
+
+    if (adaptive) {
+        // Every thread is parked in the barrier, so nothing can run
+        // before the earliest event that is already pending. Events
+        // posted across queues from that point on are at least one
+        // quantum away, which makes it safe to move the next
+        // synchronization point past the idle gap.
+        Tick earliest = MaxTick;
+        for (uint32_t i = 0; i < numMainEventQueues; ++i)
+            earliest = std::min(earliest,
+                                mainEventQueue[i]->nextPendingTick());
+
+        if (earliest < MaxTick - repeat)
+            next = std::max(next, earliest + repeat);
     }
+
+    schedule(next);
 }
 
 const char *
@@ -222,11 +222,12 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     };
 
     GlobalSyncEvent(Priority p, Flags f)
-        : Base(p, f), repeat(0)
+        : Base(p, f), repeat(0), adaptive(false)
     { }
 
-    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f)
-        : Base(p, f), repeat(_repeat)
+    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f,
+                    bool _adaptive=false)
+        : Base(p, f), repeat(_repeat), adaptive(_adaptive)
     {
         schedule(when);
     }
@@ -238,6 +239,14 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+
+    /**
+     * Skip idle stretches of simulated time. When set, the next
+     * synchronization point is placed one repeat interval after the
+     * earliest event pending on any queue rather than one repeat
+     * interval after the current tick.
+     */
+    bool adaptive;
 };
 
 } // namespace gem5
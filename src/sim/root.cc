@@ -41,6 +41,7 @@
 
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
+#include "base/pool_alloc.hh"
 #include "base/trace.hh"
 #include "debug/TimeSync.hh"
 #include "sim/core.hh"
@@ -75,9 +76,17 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostPoolHits, statistics::units::Count::get(),
+             "Number of host allocations of packets and requests served "
+             "from a pool"),
+    ADD_STAT(hostPoolMisses, statistics::units::Count::get(),
+             "Number of host allocations of packets and requests that "
+             "required a new slab"),
 
     statTime(true),
-    startTick(0)
+    startTick(0),
+    startPoolHits(0),
+    startPoolMisses(0)
 {
     simFreq.scalar(sim_clock::Frequency);
     simTicks.functor([this]() { return curTick() - startTick; });
@@ -88,6 +97,13 @@ Root::RootStats::RootStats()
         .prereq(hostMemory)
         ;
 
+    hostPoolHits.functor([this]() {
+            return pool_alloc::hits() - startPoolHits;
+        });
+    hostPoolMisses.functor([this]() {
+            return pool_alloc::misses() - startPoolMisses;
+        });
+
     hostSeconds
         .functor([this]() {
                 Time now;
@@ -108,6 +124,8 @@ Root::RootStats::resetStats()
 {
     statTime.setTimer();
     startTick = curTick();
+    startPoolHits = pool_alloc::hits();
+    startPoolMisses = pool_alloc::misses();
 
     statistics::Group::resetStats();
 }
@@ -187,6 +205,11 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    simQuantumAdaptive = p.sim_quantum_adaptive;
+
+    setMainEventQueueBackend(p.eventq_backend == enums::calendar ?
+                             EventQueue::Backend::Calendar :
+                             EventQueue::Backend::SortedList);
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -110,6 +110,9 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        statistics::Value hostPoolHits;
+        statistics::Value hostPoolMisses;
+
         static RootStats instance;
 
       private:
@@ -120,6 +123,9 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+
+        uint64_t startPoolHits;
+        uint64_t startPoolMisses;
     };
 
   public:
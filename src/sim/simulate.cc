@@ -220,7 +220,8 @@ simulate(Tick num_cycles)
 
         quantum_event.reset(
             new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
-                                EventBase::Progress_Event_Pri, 0));
+                                EventBase::Progress_Event_Pri, 0,
+                                simQuantumAdaptive));
 
         inParallelMode = true;
     }
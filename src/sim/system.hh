@@ -248,17 +248,20 @@ class System : public SimObject, public PCEventScope
     /**
      * Is the system in atomic mode?
      *
-     * There are currently two different atomic memory modes:
-     * 'atomic', which supports caches; and 'atomic_noncaching', which
-     * bypasses caches. The latter is used by hardware virtualized
-     * CPUs. SimObjects are expected to use Port::sendAtomic() and
-     * Port::recvAtomic() when accessing memory in this mode.
+     * There are currently three different atomic memory modes:
+     * 'atomic', which supports caches; 'atomic_noncaching', which
+     * bypasses caches; and 'atomic_warming', in which caches only
+     * maintain their tags. The second is used by hardware virtualized
+     * CPUs, the third to quickly warm caches. SimObjects are expected
+     * to use Port::sendAtomic() and Port::recvAtomic() when accessing
+     * memory in these modes.
      */
     bool
     isAtomicMode() const
     {
         return memoryMode == enums::atomic ||
-            memoryMode == enums::atomic_noncaching;
+            memoryMode == enums::atomic_noncaching ||
+            memoryMode == enums::atomic_warming;
     }
 
     /**
@@ -280,6 +283,20 @@ class System : public SimObject, public PCEventScope
     {
         return memoryMode == enums::atomic_noncaching;
     }
+
+    /**
+     * Are caches being warmed?
+     *
+     * In this mode caches keep their tags, coherence state and
+     * replacement state as they would in timing mode, but writes are
+     * also written through, so memory always holds the latest data.
+     * Prefetchers are neither trained nor issue any prefetches.
+     */
+    bool
+    warmingCaches() const
+    {
+        return memoryMode == enums::atomic_warming;
+    }
     /** @} */
 
     /** @{ */
@@ -288,7 +305,8 @@ class System : public SimObject, public PCEventScope
      *
      * \warn This should only be used by the Python world. The C++
      * world should use one of the query functions above
-     * (isAtomicMode(), isTimingMode(), bypassCaches()).
+     * (isAtomicMode(), isTimingMode(), bypassCaches(),
+     * warmingCaches()).
      */
     enums::MemoryMode getMemoryMode() const { return memoryMode; }
 
@@ -0,0 +1,139 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run a DRAM controller through long idle periods separated by short
+bursts of traffic, once simulating every refresh and once skipping the
+refreshes of the idle ranks, each in a gem5 process of its own. The
+stats are dumped in the middle of idle periods as well as after the
+traffic, and every dump must be the same in both runs. Exits with a
+non-zero status if they differ.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description="Idle refresh skipping test")
+parser.add_argument(
+    "--skip-idle-refresh",
+    choices=["on", "off"],
+    default=None,
+    help="Run the traffic once, skipping idle refreshes or not",
+)
+
+args = parser.parse_args()
+
+
+def read_stats(outdir):
+    """Get the stats of every dump, leaving out the host stats."""
+    stats = []
+    with open(os.path.join(outdir, "stats.txt")) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) < 2 or fields[0].startswith(("host", "-")):
+                continue
+            stats.append((fields[0], fields[1]))
+    return stats
+
+
+if args.skip_idle_refresh is None:
+    stats = {}
+    for skip in ("off", "on"):
+        outdir = os.path.join(m5.options.outdir, f"skip_{skip}")
+        subprocess.run(
+            [
+                sys.executable,
+                f"--outdir={outdir}",
+                os.path.abspath(__file__),
+                f"--skip-idle-refresh={skip}",
+            ],
+            check=True,
+        )
+        stats[skip] = read_stats(outdir)
+
+    errors = []
+    if not stats["off"]:
+        errors.append("no stats found")
+    elif len(stats["off"]) != len(stats["on"]):
+        errors.append("the runs have different stats")
+    else:
+        for (name, value), (_, skipped) in zip(stats["off"], stats["on"]):
+            if skipped != value:
+                errors.append(f"{name}: {value} simulated, {skipped} skipped")
+
+    for error in errors:
+        print(error, file=sys.stderr)
+    sys.exit(1 if errors else 0)
+
+system = System(membus=IOXBar(width=32))
+system.clk_domain = SrcClockDomain(
+    clock="2GHz", voltage_domain=VoltageDomain(voltage="1V")
+)
+system.mem_ranges = [AddrRange("512MB")]
+
+system.tgen = PyTrafficGen()
+system.mem_ctrl = MemCtrl(
+    dram=DDR3_1600_8x8(
+        range=system.mem_ranges[0],
+        skip_idle_refresh=args.skip_idle_refresh == "on",
+    )
+)
+system.tgen.port = system.membus.cpu_side_ports
+system.mem_ctrl.port = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+us = 1000000
+tgen = system.tgen
+end = 16 * 1024 * 1024
+# idle periods of many refresh intervals, separated by reads, a mix of
+# reads and writes, and writes
+tgen.start(
+    [
+        tgen.createIdle(100 * us),
+        tgen.createLinear(2 * us, 0, end, 64, 10000, 10000, 100, 0),
+        tgen.createIdle(55 * us + 500000),
+        tgen.createRandom(2 * us, 0, end, 64, 5000, 20000, 50, 0),
+        tgen.createIdle(200 * us),
+        tgen.createLinear(1 * us, 0, end, 64, 10000, 10000, 0, 0),
+        tgen.createIdle(500 * us),
+    ]
+)
+
+# dump during idle periods, and once everything has been idle again for
+# a while
+for ticks in (50 * us, 53 * us, 77 * us, 220 * us, 100 * us):
+    m5.simulate(ticks)
+    m5.stats.dump()
@@ -70,6 +70,24 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+gem5_verify_config(
+    name="cache_warming",
+    verifiers=(),  # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), "warming-run.py"),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    length=constants.quick_tag,
+)
+
+gem5_verify_config(
+    name="dram_idle_refresh_skip",
+    verifiers=(),  # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), "refresh-skip-run.py"),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    length=constants.quick_tag,
+)
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
@@ -0,0 +1,147 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Warm the caches of a small two-level hierarchy with a memory tester,
+once in timing mode and once in the atomic_warming mode, each in a gem5
+process of its own, and check that the caches saw the same hits, misses,
+replacements and writebacks. The tester waits long enough between
+accesses for none of them to overlap, which makes the timing warm-up
+the reference for the warming mode. Exits with a non-zero status if the
+two runs differ.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description="Cache warming test")
+parser.add_argument(
+    "--mem-mode",
+    choices=["timing", "atomic_warming"],
+    default=None,
+    help="Run a single warm-up in this mode",
+)
+
+args = parser.parse_args()
+
+compared_stats = (
+    "demandHits::total",
+    "demandMisses::total",
+    "replacements",
+    "writebacks::total",
+)
+
+
+def cache_stats(outdir):
+    stats = {}
+    with open(os.path.join(outdir, "stats.txt")) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            name = fields[0]
+            if ".l1c." in name or ".l2c." in name:
+                if name.endswith(compared_stats):
+                    stats[name] = fields[1]
+    return stats
+
+
+if args.mem_mode is None:
+    stats = {}
+    for mode in ("timing", "atomic_warming"):
+        outdir = os.path.join(m5.options.outdir, mode)
+        subprocess.run(
+            [
+                sys.executable,
+                f"--outdir={outdir}",
+                os.path.abspath(__file__),
+                f"--mem-mode={mode}",
+            ],
+            check=True,
+        )
+        stats[mode] = cache_stats(outdir)
+
+    errors = []
+    if not stats["timing"]:
+        errors.append("no cache stats found")
+    for name, value in stats["timing"].items():
+        warm_value = stats["atomic_warming"].get(name)
+        if warm_value != value:
+            errors.append(f"{name}: timing {value}, warming {warm_value}")
+
+    for error in errors:
+        print(error, file=sys.stderr)
+    sys.exit(1 if errors else 0)
+
+# A single tester, with a long enough interval between accesses for
+# each of them to be done before the next one starts. The working set
+# is larger than both caches.
+system = System(
+    cpu=MemTest(
+        max_loads=20000,
+        interval=1000,
+        percent_functional=0,
+        percent_uncacheable=0,
+        progress_interval=0,
+    ),
+    physmem=SimpleMemory(),
+    membus=SystemXBar(),
+)
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=system.voltage_domain
+)
+
+cache_params = dict(
+    tag_latency=2,
+    data_latency=2,
+    response_latency=2,
+    mshrs=4,
+    tgts_per_mshr=8,
+)
+system.cpu.l1c = Cache(size="2kB", assoc=2, **cache_params)
+system.l2bus = L2XBar()
+system.l2c = Cache(size="16kB", assoc=4, **cache_params)
+
+system.cpu.port = system.cpu.l1c.cpu_side
+system.cpu.l1c.mem_side = system.l2bus.cpu_side_ports
+system.l2c.cpu_side = system.l2bus.mem_side_ports
+system.l2c.mem_side = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = args.mem_mode
+
+m5.instantiate()
+exit_event = m5.simulate()
+if exit_event.getCause() != "maximum number of loads reached":
+    sys.exit(1)
@@ -0,0 +1,87 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run a small memory test system and dump its stats a few times, both as
+text and in the columnar format, and check that every dump made it to
+the files. Exits with a non-zero status if anything is missing.
+"""
+
+import os
+import sys
+
+import m5
+from m5.objects import *
+from m5.stats.columnar import ColumnarStats
+
+num_dumps = 4
+
+system = System(
+    cpu=MemTest(max_loads=1e9, progress_interval=0),
+    physmem=SimpleMemory(),
+    membus=SystemXBar(),
+)
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=system.voltage_domain
+)
+system.cpu.port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.stats.addStatVisitor("columnar://stats.gcs")
+
+m5.instantiate()
+for i in range(num_dumps):
+    m5.simulate(1000000)
+    m5.stats.dump()
+
+errors = []
+
+with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+    text = f.read()
+if text.count("Begin Simulation Statistics") != num_dumps:
+    errors.append("stats.txt does not hold every dump")
+for stat in ("simTicks", "system.cpu.numReads", "system.physmem.numReads"):
+    if stat not in text:
+        errors.append(f"{stat} is missing from stats.txt")
+
+stats = ColumnarStats(os.path.join(m5.options.outdir, "stats.gcs"))
+if len(stats) != num_dumps:
+    errors.append(f"stats.gcs holds {len(stats)} of {num_dumps} dumps")
+elif "system.cpu.numReads" not in stats:
+    errors.append("system.cpu.numReads is missing from stats.gcs")
+else:
+    reads = stats["system.cpu.numReads"]
+    if not all(a < b for a, b in zip(reads, reads[1:])):
+        errors.append(f"system.cpu.numReads does not increase: {reads}")
+
+for error in errors:
+    print(error, file=sys.stderr)
+sys.exit(1 if errors else 0)
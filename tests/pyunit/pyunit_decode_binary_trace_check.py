@@ -0,0 +1,97 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import importlib.util
+import io
+import os
+import struct
+import unittest
+
+_path = os.path.join(
+    os.path.dirname(__file__), "..", "..", "util", "decode_binary_trace.py"
+)
+_spec = importlib.util.spec_from_file_location("decode_binary_trace", _path)
+decode_binary_trace = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(decode_binary_trace)
+
+
+def _string(id, text):
+    return struct.pack("<BII", ord("S"), id, len(text)) + text
+
+
+def _message(when, name, flag, fmt, args):
+    return struct.pack("<BQIIII", ord("M"), when, name, flag, fmt, len(args))
+
+
+def _trace(fmt, args):
+    """A trace with one message, as src/base/binary_trace.cc writes it."""
+    return (
+        decode_binary_trace.MAGIC
+        + struct.pack("<II", decode_binary_trace.VERSION, 0)
+        + _string(0, b"system")
+        + _string(1, b"Flag")
+        + _string(2, fmt)
+        + _message(1, 0, 1, 2, args)
+        + args
+    )
+
+
+class DecodeBinaryTraceTestSuite(unittest.TestCase):
+    """Test cases for util/decode_binary_trace.py"""
+
+    def decode(self, fmt, args):
+        out = io.StringIO()
+        decode_binary_trace.Decoder().decode(_trace(fmt, args), out)
+        return out.getvalue()
+
+    def test_integers(self):
+        args = struct.pack("<BIBi", ord("I"), 0x1234, ord("i"), -5)
+        self.assertEqual(
+            self.decode(b"%#x %d\n", args), "      1: system: 0x1234 -5\n"
+        )
+
+    def test_enums(self):
+        # The arguments of BinaryTraceTest.IntegerLikeArgs: an enum, an
+        # enum with int16_t as underlying type, a BitUnion32, an enum with
+        # uint8_t as underlying type and an enum with a stream operator.
+        # The expected output is the one of cprintf.
+        args = b"".join(
+            (
+                struct.pack("<Bi", ord("i"), 0x1F),
+                struct.pack("<Bh", ord("h"), -2),
+                struct.pack("<BI", ord("I"), 0xABCD),
+                struct.pack("<BI", ord("s"), 1) + b"A",
+                struct.pack("<BI", ord("s"), 12) + b"Named::Value",
+            )
+        )
+        self.assertEqual(
+            self.decode(b"%#x %#x %#x %s %s\n", args),
+            "      1: system: 0x1f 0xfffe 0xabcd A Named::Value\n",
+        )
+        self.assertEqual(
+            self.decode(b"%08x %d %+d %5s %x\n", args),
+            "      1: system: 0000001f -2 43981     A Named::Value\n",
+        )
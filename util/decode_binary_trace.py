@@ -0,0 +1,542 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script formats binary debug traces written with
+# --debug-format=binary. The output is the same as the text output of
+# the simulator, e.g.:
+#
+#   gem5.opt --debug-flags=Exec --debug-format=binary \
+#       --debug-file=trace.bin config.py
+#   decode_binary_trace.py m5out/trace.bin trace.txt
+#
+# See src/base/binary_trace.hh for a description of the format. The
+# format strings are interpreted like base/cprintf.hh does, including
+# its quirks, so that both outputs can be compared with diff.
+
+import argparse
+import io
+import math
+import mmap
+import struct
+import sys
+
+MAGIC = b"gem5trce"
+VERSION = 1
+
+STRING_RECORD = ord("S")
+MESSAGE_RECORD = ord("M")
+
+MAX_TICK = 2**64 - 1
+
+# Struct format of every argument type but strings
+ARG_FORMATS = {
+    ord("h"): "<h",
+    ord("H"): "<H",
+    ord("i"): "<i",
+    ord("I"): "<I",
+    ord("q"): "<q",
+    ord("Q"): "<Q",
+    ord("d"): "<d",
+    ord("c"): "<b",
+    ord("C"): "<B",
+    ord("?"): "<B",
+    ord("P"): "<Q",
+}
+STRING_ARG = ord("s")
+
+INTEGER_TYPES = "hHiIqQ"
+
+
+class Arg:
+    """A recorded argument and the C++ type it had."""
+
+    __slots__ = ("kind", "value", "size", "signed")
+
+    def __init__(self, kind, value):
+        self.kind = kind
+        self.value = value
+        if kind in INTEGER_TYPES:
+            self.size = struct.calcsize(ARG_FORMATS[ord(kind)])
+            self.signed = kind.islower()
+
+
+def parse_args(data):
+    args = []
+    pos = 0
+    while pos < len(data):
+        kind = data[pos]
+        pos += 1
+        if kind == STRING_ARG:
+            (length,) = struct.unpack_from("<I", data, pos)
+            pos += 4
+            value = data[pos : pos + length].decode("latin-1")
+            pos += length
+        else:
+            fmt = ARG_FORMATS[kind]
+            (value,) = struct.unpack_from(fmt, data, pos)
+            pos += struct.calcsize(fmt)
+        args.append(Arg(chr(kind), value))
+    return args
+
+
+class Spec:
+    """A conversion specification, see cp::Format."""
+
+    NONE, STRING, INTEGER, CHARACTER, FLOATING = range(5)
+    BEST, FIXED, SCIENTIFIC = range(3)
+
+    def __init__(self):
+        self.raw = ""
+        self.note = ""
+        self.alternate = False
+        self.flush_left = False
+        self.print_sign = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = 10
+        self.format = Spec.NONE
+        self.float_format = Spec.BEST
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+    def copy(self):
+        spec = Spec.__new__(Spec)
+        for slot in vars(self):
+            setattr(spec, slot, getattr(self, slot))
+        return spec
+
+
+def parse_spec(fmt, start):
+    """Parse the specification at fmt[start], see cp::Print::processFlag."""
+    spec = Spec()
+    done = False
+    end_number = False
+    have_precision = False
+    number = 0
+    pos = start
+
+    while not done:
+        pos += 1
+        c = fmt[pos] if pos < len(fmt) else ""
+        if "0" <= c <= "9":
+            if end_number:
+                continue
+        elif number > 0:
+            end_number = True
+
+        if c == "s":
+            spec.format = Spec.STRING
+            done = True
+        elif c == "c":
+            spec.format = Spec.CHARACTER
+            done = True
+        elif c == "l":
+            continue
+        elif c == "p":
+            spec.format = Spec.INTEGER
+            spec.base = 16
+            spec.alternate = True
+            done = True
+        elif c in "xX":
+            spec.uppercase = c == "X"
+            spec.base = 16
+            spec.format = Spec.INTEGER
+            done = True
+        elif c == "o":
+            spec.base = 8
+            spec.format = Spec.INTEGER
+            done = True
+        elif c in "diu":
+            spec.format = Spec.INTEGER
+            done = True
+        elif c in "gG":
+            spec.uppercase = c == "G"
+            spec.format = Spec.FLOATING
+            spec.float_format = Spec.BEST
+            done = True
+        elif c in "eE":
+            spec.uppercase = c == "E"
+            spec.format = Spec.FLOATING
+            spec.float_format = Spec.SCIENTIFIC
+            done = True
+        elif c == "f":
+            spec.format = Spec.FLOATING
+            spec.float_format = Spec.FIXED
+            done = True
+        elif c == "n":
+            spec.note = "we don't do %n!!!\n"
+            done = True
+        elif c == "#":
+            spec.alternate = True
+        elif c == "-":
+            spec.flush_left = True
+        elif c == "+":
+            spec.print_sign = True
+        elif c == " ":
+            pass
+        elif c == ".":
+            spec.width = number
+            spec.precision = 0
+            have_precision = True
+            number = 0
+            end_number = False
+        elif c == "0" and number == 0:
+            spec.fill_zero = True
+        elif "0" <= c <= "9":
+            number = number * 10 + int(c)
+        elif c == "*":
+            if have_precision:
+                spec.get_precision = True
+            else:
+                spec.get_width = True
+        else:
+            done = True
+
+        if end_number:
+            if have_precision:
+                spec.precision = number
+            else:
+                spec.width = number
+            end_number = False
+            number = 0
+
+        if done:
+            if spec.format == Spec.INTEGER and have_precision:
+                spec.width = spec.precision
+                spec.fill_zero = True
+            elif (
+                spec.format == Spec.FLOATING
+                and not have_precision
+                and spec.fill_zero
+            ):
+                spec.precision = spec.width
+
+    spec.raw = fmt[start : pos + 1]
+    return pos + 1, spec
+
+
+def compile_format(fmt):
+    """Split a format string into literal strings and Specs."""
+    tokens = []
+    literal = []
+    pos = 0
+    while pos < len(fmt):
+        c = fmt[pos]
+        if c == "%":
+            if fmt[pos + 1 : pos + 2] == "%":
+                literal.append("%")
+                pos += 2
+                continue
+            if literal:
+                tokens.append("".join(literal))
+                literal = []
+            pos, spec = parse_spec(fmt, pos)
+            tokens.append(spec)
+        elif c == "\r":
+            pos += 1
+            if fmt[pos : pos + 1] != "\n":
+                literal.append("\n")
+        else:
+            literal.append(c)
+            pos += 1
+    if literal:
+        tokens.append("".join(literal))
+    return tokens
+
+
+def pad(text, width, fill, left):
+    if len(text) >= width:
+        return text
+    padding = fill * (width - len(text))
+    return text + padding if left else padding + text
+
+
+def general(value, precision, uppercase=False):
+    text = "%.*g" % (precision, value)
+    return text.upper() if uppercase else text
+
+
+class Formatter:
+    """Formats one message, see cp::Print."""
+
+    def __init__(self):
+        # The precision of the stream is only reset after the message
+        self.precision = 6
+
+    def stream_str(self, arg):
+        """The result of streaming an argument to a fresh stream."""
+        if arg.kind in "cC":
+            return chr(arg.value & 0xFF)
+        if arg.kind == "P":
+            return hex(arg.value) if arg.value else "0"
+        if arg.kind == "d":
+            return general(arg.value, self.precision)
+        return str(arg.value)
+
+    def format_integer(self, spec, arg):
+        width = spec.width
+        prefix = ""
+        if spec.alternate and spec.fill_zero:
+            if spec.base == 16:
+                prefix = "0x"
+                width -= 2
+            elif spec.base == 8:
+                prefix = "0"
+                width -= 1
+        fill = "0" if spec.fill_zero else " "
+        left = spec.flush_left and not spec.fill_zero
+
+        kind = arg.kind
+        if kind in "cC?":
+            value, size, signed = arg.value, 4, True
+        elif kind in INTEGER_TYPES:
+            value, size, signed = arg.value, arg.size, arg.signed
+        elif kind == "P":
+            text = hex(arg.value) if arg.value else "0"
+            return prefix + pad(text, width, fill, left)
+        elif kind == "d":
+            text = general(arg.value, self.precision, spec.uppercase)
+            if spec.print_sign and math.copysign(1, arg.value) > 0:
+                text = "+" + text
+            return prefix + pad(text, width, fill, left)
+        else:
+            return prefix + pad(arg.value, width, fill, left)
+
+        if spec.base == 10:
+            if value < 0:
+                text = "-" + str(-value)
+            elif spec.print_sign and signed:
+                text = "+" + str(value)
+            else:
+                text = str(value)
+        else:
+            value &= (1 << (8 * size)) - 1
+            text = format(value, "x" if spec.base == 16 else "o")
+            if spec.alternate and not spec.fill_zero and value:
+                text = ("0x" if spec.base == 16 else "0") + text
+            if spec.uppercase:
+                text = text.upper()
+        return prefix + pad(text, width, fill, left)
+
+    def format_float(self, spec, arg):
+        if arg.kind != "d":
+            return "<bad arg type for float format>"
+
+        precision = spec.precision
+        fill = "0" if spec.fill_zero else " "
+        if spec.float_format == Spec.SCIENTIFIC:
+            if precision == 0:
+                self.precision = 1
+                text = general(arg.value, 1, spec.uppercase)
+            elif precision != -1:
+                self.precision = precision
+                text = "%.*e" % (precision, arg.value)
+                if spec.uppercase:
+                    text = text.upper()
+            else:
+                text = general(arg.value, self.precision, spec.uppercase)
+        elif spec.float_format == Spec.FIXED and precision != -1:
+            self.precision = precision
+            text = "%.*f" % (precision, arg.value)
+        else:
+            if precision != -1:
+                self.precision = precision
+            text = general(arg.value, self.precision)
+        return pad(text, spec.width, fill, False)
+
+    def format_arg(self, spec, arg):
+        if spec.format == Spec.CHARACTER:
+            if arg.kind in "cC" or arg.kind in INTEGER_TYPES:
+                return chr(arg.value & 0xFF)
+            return "<bad arg type for char format>"
+        if spec.format == Spec.INTEGER:
+            return self.format_integer(spec, arg)
+        if spec.format == Spec.FLOATING:
+            return self.format_float(spec, arg)
+        if spec.format == Spec.STRING:
+            if spec.width > 0:
+                saved, self.precision = self.precision, 6
+                text = self.stream_str(arg)
+                self.precision = saved
+                return pad(text, spec.width, " ", spec.flush_left)
+            return self.stream_str(arg)
+        return "<bad format>"
+
+    def format(self, tokens, args):
+        out = []
+        pos = 0
+        spec = None
+        cont = False
+        for arg in args:
+            # Like cp::Print, once a width or precision argument was
+            # seen, all other arguments use the same specification
+            if not cont:
+                while pos < len(tokens) and isinstance(tokens[pos], str):
+                    out.append(tokens[pos])
+                    pos += 1
+                if pos < len(tokens):
+                    spec = tokens[pos]
+                    out.append(spec.note)
+                    pos += 1
+                else:
+                    spec = Spec()
+
+            if spec.get_width or spec.get_precision:
+                spec = spec.copy()
+                number = arg.value if arg.kind == "i" else 0
+                cont = True
+                if spec.get_width:
+                    spec.get_width = False
+                    spec.width = number
+                else:
+                    spec.get_precision = False
+                    spec.precision = number
+                continue
+
+            out.append(self.format_arg(spec, arg))
+
+        for token in tokens[pos:]:
+            if isinstance(token, str):
+                out.append(token)
+            else:
+                out.append("<extra arg>%" + token.raw[2:])
+        return "".join(out)
+
+
+class Decoder:
+    def __init__(self, ticks=True, flags=False, only=None):
+        self.ticks = ticks
+        self.flags = flags
+        self.only = only
+        self.strings = {}
+        self.formats = {}
+
+    def decode(self, data, out):
+        if data[:8] != MAGIC:
+            raise ValueError("Not a gem5 binary debug trace")
+        (version,) = struct.unpack_from("<I", data, 8)
+        if version != VERSION:
+            raise ValueError(f"Unsupported binary trace version {version}")
+
+        pos = 16
+        end = len(data)
+        while pos < end:
+            kind = data[pos]
+            if kind == STRING_RECORD:
+                if pos + 9 > end:
+                    break
+                id, length = struct.unpack_from("<II", data, pos + 1)
+                pos += 9
+                if pos + length > end:
+                    break
+                raw = data[pos : pos + length]
+                self.strings[id] = raw.decode("latin-1")
+                pos += length
+            elif kind == MESSAGE_RECORD:
+                if pos + 25 > end:
+                    break
+                when, name, flag, fmt, size = struct.unpack_from(
+                    "<QIIII", data, pos + 1
+                )
+                pos += 25
+                if pos + size > end:
+                    break
+                args = data[pos : pos + size]
+                pos += size
+                self.message(out, when, name, flag, fmt, args)
+            else:
+                # The rest of the file is empty if the simulator did not
+                # close the trace
+                break
+
+    def message(self, out, when, name, flag, fmt, args):
+        flag = self.strings[flag]
+        if self.only is not None and flag not in self.only:
+            return
+
+        tokens = self.formats.get(fmt)
+        if tokens is None:
+            tokens = compile_format(self.strings[fmt])
+            self.formats[fmt] = tokens
+
+        line = []
+        if self.ticks and when != MAX_TICK:
+            line.append("%7d: " % when)
+        if self.flags and flag:
+            line.append(flag + ": ")
+        name = self.strings[name]
+        if name:
+            line.append(name + ": ")
+        line.append(Formatter().format(tokens, parse_args(args)))
+        out.write("".join(line))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Format a binary gem5 debug trace as text."
+    )
+    parser.add_argument("trace", help="Binary trace file")
+    parser.add_argument(
+        "output", nargs="?", help="Text output file [Default: stdout]"
+    )
+    parser.add_argument(
+        "--show-flags",
+        action="store_true",
+        help="Prefix messages with their debug flag, like FmtFlag",
+    )
+    parser.add_argument(
+        "--no-ticks",
+        action="store_true",
+        help="Do not prefix messages with their tick, like FmtTicksOff",
+    )
+    parser.add_argument(
+        "--flags",
+        metavar="FLAG[,FLAG]",
+        help="Only print messages of the given debug flags",
+    )
+    args = parser.parse_args()
+
+    only = set(args.flags.split(",")) if args.flags else None
+    decoder = Decoder(not args.no_ticks, args.show_flags, only)
+    # Strings are passed through byte by byte, like the simulator does
+    if args.output:
+        out = open(args.output, "w", encoding="latin-1")
+    else:
+        out = io.TextIOWrapper(sys.stdout.buffer, encoding="latin-1")
+    with open(args.trace, "rb") as f:
+        if f.seek(0, 2) == 0:
+            sys.exit(f"{args.trace} is empty")
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as data:
+            decoder.decode(data, out)
+    out.close()
+
+
+if __name__ == "__main__":
+    main()